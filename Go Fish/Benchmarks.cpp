@@ -0,0 +1,91 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <map>
+#include "MicroBenchmark.h"
+#include "EngineBenchmarks.h"
+
+#pragma region Command Line
+
+/// <summary>
+/// Reads the command line options.  Returns false if they are invalid.
+/// --samples (count)       Timed samples per benchmark.  Defaults to 200.
+/// --warmup (count)        Untimed samples before the timed ones.  Defaults to 20.
+/// --filter (text)         Only run benchmarks whose name contains text.
+/// --json                  Print the results as JSON instead of a table.
+/// --output (file)         Also write the JSON results to file, e.g. to save a baseline.
+/// --compare (file)        Compare the medians against JSON results saved with --output and flag regressions.
+/// --threshold (percent)   How much slower a median can get before it is a regression.  Defaults to 10.
+/// </summary>
+bool ParseOptions(int argc, char* argv[], MicroBenchmarkOptions& options) {
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (arg == "--samples" && hasValue) {
+			options.samples = std::max(1, std::stoi(argv[++i]));
+		}
+		else if (arg == "--warmup" && hasValue) {
+			options.warmupSamples = std::max(0, std::stoi(argv[++i]));
+		}
+		else if (arg == "--filter" && hasValue) {
+			options.filter = argv[++i];
+		}
+		else if (arg == "--json") {
+			options.json = true;
+		}
+		else if (arg == "--output" && hasValue) {
+			options.outputPath = argv[++i];
+		}
+		else if (arg == "--compare" && hasValue) {
+			options.baselinePath = argv[++i];
+		}
+		else if (arg == "--threshold" && hasValue) {
+			options.regressionPercent = std::stod(argv[++i]);
+		}
+		else {
+			std::cout << "Unknown or incomplete option: " << arg << "\n";
+			return false;
+		}
+	}
+
+	return true;
+}
+
+#pragma endregion
+
+/// <summary>
+/// Times the engine's hot paths.  Returns 2 if --compare found a regression.
+/// </summary>
+int main(int argc, char* argv[]) {
+	MicroBenchmarkOptions options;
+	if (!ParseOptions(argc, argv, options))
+		return 1;
+
+	std::map<std::string, double> baseline;
+	if (options.baselinePath != "") {
+		bool ok;
+		baseline = MicroBenchmarkSuite::ReadBaseline(options.baselinePath, ok);
+		if (!ok) {
+			std::cout << "Couldn't read " << options.baselinePath << "\n";
+			return 1;
+		}
+	}
+
+	MicroBenchmarkSuite suite(options);
+	RunEngineBenchmarks(suite);
+	if (options.json)
+		std::cout << suite.ToJson();
+
+	if (options.outputPath != "") {
+		std::ofstream file(options.outputPath);
+		file << suite.ToJson();
+	}
+
+	if (!options.json)
+		std::cout << "(checksum " << suite.checksum << ")\n";
+
+	if (options.baselinePath != "" && suite.CompareToBaseline(baseline) > 0)
+		return 2;
+
+	return 0;
+}
\ No newline at end of file
@@ -62,7 +62,6 @@ std::shared_ptr<int[]> BigWheelSieve(int requiredPrimesCount) {
 			compositeWheelIndexQueue.pop();
 			int compositeWheelIndex = queValue.second;
 			int compositeWheel = compositeWheels[compositeWheelIndex];
-			int compositeWheelPrimeStartingIndex = compositeWheelPrimeStartingIndexs[compositeWheelIndex];
 			int compositeWheelBasePrimeIndex = compositeWheelToPrimeWheelIndex[compositeWheelIndex];
 			int wheelRepetitionCircumfrance = wheelRepititionCircumfrances[compositeWheelBasePrimeIndex];
 			int currentPrimeMultiplerIndex = compositeWheelPrimeMultiplierIndexes[compositeWheelIndex];
@@ -207,7 +206,7 @@ std::shared_ptr<int[]> BigWheelSieve(int requiredPrimesCount) {
 
 			//for (const auto& stitch : stitches[primesNextWheelIndex]) {//TODO: Make stitches pointers/reference to the bigWheel values instead of using tempNum/tempBigWheelIndex
 			std::vector<int>& stitchesForCurrentWheel = stitches[primesNextWheelIndex];
-			for (int i = 0; i < stitchesForCurrentWheel.size(); ++i) {
+			for (int i = 0; i < static_cast<int>(stitchesForCurrentWheel.size()); ++i) {
 				//Stitch by combining the value at the index of the stitch with the value at the previous index.
 				while (tempNum < stitchesForCurrentWheel[i]) {
 					int numToAdd = bigWheel[++tempBigWheelIndex];
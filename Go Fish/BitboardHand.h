@@ -0,0 +1,211 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <cstdint>
+#include <bit>
+#include "ConstantsAndGlobals.h"
+#include "Card.h"
+
+/// <summary>
+/// BitboardHand stores a hand as one bit per CardID in a 64 bit mask.
+/// Because CardID is cardNumber * SUITS_PER_DECK + suit, each card number is a 4 bit nibble, so checking, counting and moving
+///		all cards of a number are a few mask and popcount operations.  Nothing is allocated.
+/// Has the same hand interface as ListHand so the two can be swapped in BasicGameState and benchmarked.
+/// </summary>
+class BitboardHand {
+public:
+
+#pragma region Constructors/Properties
+
+	BitboardHand() : cards(0) {}
+	BitboardHand(uint64_t Cards) : cards(Cards) {}
+
+	/// <summary>
+	/// Bit CardID is set if the hand has that card.
+	/// </summary>
+	uint64_t cards;
+
+	/// <summary>
+	/// Mask with all SUITS_PER_DECK bits of cardNumber set.
+	/// </summary>
+	static uint64_t NumberMask(int cardNumber) {
+		return ((1ull << SUITS_PER_DECK) - 1) << (cardNumber * SUITS_PER_DECK);
+	}
+
+	static uint64_t CardMask(const Card& card) {
+		return 1ull << card.CardID;
+	}
+
+#pragma endregion
+
+#pragma region Getters
+
+	int Count() const {
+		return std::popcount(cards);
+	}
+
+	bool Contains(const Card& card) const {
+		return (cards & CardMask(card)) != 0;
+	}
+
+	int CountOfNumber(int cardNumber) const {
+		return std::popcount(cards & NumberMask(cardNumber));
+	}
+
+	bool HasNumber(int cardNumber) const {
+		return (cards & NumberMask(cardNumber)) != 0;
+	}
+
+	/// <summary>
+	/// Gets a mask with bit cardNumber set for each card number in the hand.
+	/// </summary>
+	uint16_t HeldNumbers() const {
+		//Fold each card number's nibble into its lowest bit, so bit 4 * cardNumber is set if the hand has any of cardNumber.
+		uint64_t numbers = cards | (cards >> 1);
+		numbers = (numbers | (numbers >> 2)) & 0x0001111111111111ull;
+
+		//Squeeze the bits together by closing the gaps between pairs, then quads, and so on.
+		numbers = (numbers | (numbers >> 3)) & 0x0303030303030303ull;
+		numbers = (numbers | (numbers >> 6)) & 0x000F000F000F000Full;
+		numbers = (numbers | (numbers >> 12)) & 0x000000FF000000FFull;
+		numbers = (numbers | (numbers >> 24)) & 0xFFFFull;
+
+		return static_cast<uint16_t>(numbers);
+	}
+
+	/// <summary>
+	/// Fills numbers with each card number in the hand from lowest to highest.
+	/// </summary>
+	/// <returns>The number of card numbers in the hand.</returns>
+	int HeldNumbers(int(&numbers)[CARDS_PER_SUIT]) const {
+		int count = 0;
+		for (uint32_t mask = HeldNumbers(); mask != 0; mask &= mask - 1) {
+			numbers[count++] = std::countr_zero(mask);
+		}
+
+		return count;
+	}
+
+#pragma endregion
+
+#pragma region Adding/Removing
+
+	void AddCard(const Card& card) {
+		cards |= CardMask(card);
+	}
+
+	void AddCards(const Card* newCards, int cardCount) {
+		for (int i = 0; i < cardCount; i++) {
+			cards |= CardMask(newCards[i]);
+		}
+	}
+
+	void Emplace(int cardID) {
+		cards |= 1ull << cardID;
+	}
+
+	void Remove(const Card& card) {
+		cards &= ~CardMask(card);
+	}
+
+	void Clear() {
+		cards = 0;
+	}
+
+	uint64_t Cards() const {
+		return cards;
+	}
+
+	void SetCards(uint64_t Cards) {
+		cards = Cards;
+	}
+
+	uint64_t CardsOfNumber(int cardNumber) const {
+		return cards & NumberMask(cardNumber);
+	}
+
+	/// <summary>
+	/// Moves the cards in the mask from this hand to the other hand.  Cards in the mask that aren't in this hand are ignored.
+	/// </summary>
+	/// <returns>The number of cards moved.</returns>
+	int GiveCards(uint64_t moving, BitboardHand& other) {
+		moving &= cards;
+		cards &= ~moving;
+		other.cards |= moving;
+
+		return std::popcount(moving);
+	}
+
+	void RemoveCards(uint64_t removing) {
+		cards &= ~removing;
+	}
+
+	/// <summary>
+	/// The bits are always in order, so there is nothing to sort.  Only here to match ListHand.
+	/// </summary>
+	void Sort() {}
+
+	/// <summary>
+	/// Moves every card with a card number of cardNumber from this hand to the other hand.
+	/// </summary>
+	/// <returns>The number of cards moved.</returns>
+	int GiveAllOfNumber(int cardNumber, BitboardHand& other) {
+		uint64_t moved = cards & NumberMask(cardNumber);
+		cards ^= moved;
+		other.cards |= moved;
+
+		return std::popcount(moved);
+	}
+
+	/// <summary>
+	/// Removes every card with a card number of cardNumber from the hand.  Used when turning in a four of a kind.
+	/// </summary>
+	void RemoveAllOfNumber(int cardNumber) {
+		cards &= ~NumberMask(cardNumber);
+	}
+
+#pragma endregion
+
+#pragma region ToString
+
+	/// <summary>
+	/// Converts the hand to a string in the same format as linkedList::ToString.
+	/// </summary>
+	std::string ToString(std::string label = "") const {
+		std::string result = "";
+		if (label != "")
+			result += label + ": ";
+
+		result += "{ ";
+		bool first = true;
+		for (uint64_t remaining = cards; remaining != 0; remaining &= remaining - 1) {
+			if (first) {
+				first = false;
+			}
+			else {
+				result += ", ";
+			}
+
+			result += Card::ToString(Card(std::countr_zero(remaining)));
+		}
+
+		result += " }";
+
+		return result;
+	}
+
+	void Print(std::string label = "") const {
+		std::cout << ToString(label) << std::endl;
+	}
+
+#pragma endregion
+
+	bool operator==(const BitboardHand& other) const {
+		return cards == other.cards;
+	}
+
+	bool operator!=(const BitboardHand& other) const {
+		return !(*this == other);
+	}
+};
\ No newline at end of file
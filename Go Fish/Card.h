@@ -72,7 +72,7 @@ public:
 		return CardID >= other.CardID;
 	}
 
-	Card(const Card& other) : CardID(other.CardID) {}
+	Card(const Card& other) = default;
 
 	static std::string ToString(const Card& card) {
 		return card.FullName();
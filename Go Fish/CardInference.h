@@ -0,0 +1,425 @@
+#pragma once
+
+#include <cstdint>
+#include <bit>
+#include <algorithm>
+#include "ConstantsAndGlobals.h"
+#include "Card.h"
+#include "Guess.h"
+#include "Random.h"
+#include "LegalMoves.h"
+#include "NPC.h"
+
+/// <summary>
+/// CardInference keeps, from one player's point of view, the probability that each card they can't see is in each other
+///		player's hand or in the deck, and updates it after every guess.
+/// The probabilities are a locations x cards matrix of floats.  Every update is a little Bayesian step on the few cards the
+///		guess was about, then a few passes of iterative proportional fitting over the whole matrix so every card's row adds up
+///		to 1 and every location's column adds up to the number of unseen cards it holds.  Those passes are plain loops over
+///		CARD_SLOTS floats per location, written so the compiler turns them into SIMD.
+/// After each update the chance that each location holds each card number is cached, so ProbabilityHolds is O(1).
+/// What is certain is kept as masks beside the matrix: cards whose location is known (the player's own hand, and cards they
+///		gave away) and card numbers each player is known to hold because they asked for them.
+/// </summary>
+class CardInference {
+public:
+	static const int DECK_LOCATION = MAX_PLAYERS;//Location number of the deck.  Players are locations 0 to MAX_PLAYERS - 1.
+	static const int LOCATIONS = MAX_PLAYERS + 1;
+	static const int CARD_SLOTS = 64;//DECK_SIZE rounded up so each row is a whole number of SIMD registers.  The extra slots stay 0.
+	static const int FITTING_PASSES = 3;
+
+private:
+	alignas(64) float probability[LOCATIONS][CARD_SLOTS];//probability[location][CardID] for unseen cards.  0 for every other card.
+	alignas(64) float unseen[CARD_SLOTS];//1 for cards whose location isn't known, 0 otherwise, so loops can mask without branching.
+	float holds[LOCATIONS][CARDS_PER_SUIT];//Cached chance each location holds at least one of each card number.
+	float expected[LOCATIONS][CARDS_PER_SUIT];//Cached expected number of each card number at each location.
+	uint64_t knownAt[LOCATIONS];//Cards known to be at each location.
+	uint64_t unknown;//Cards still in the game whose location isn't known.
+	uint16_t mustHold[LOCATIONS];//Bit cardNumber is set when the player asked for it and hasn't lost it since.
+	int sizes[LOCATIONS];//Cards at each location.
+	int observer;
+	int playerCount;
+
+	static uint64_t CardNumberMask(int cardNumber) {
+		return 0xFull << (cardNumber * SUITS_PER_DECK);
+	}
+
+	void SetUnseen(uint64_t cards) {
+		unknown = cards;
+		for (int card = 0; card < CARD_SLOTS; card++) {
+			unseen[card] = static_cast<float>(unknown >> card & 1);
+		}
+	}
+
+	/// <summary>
+	/// Takes cards out of the matrix because their location is now known (or they were turned in).
+	/// </summary>
+	void ForgetCards(uint64_t cards) {
+		SetUnseen(unknown & ~cards);
+		for (int location = 0; location < LOCATIONS; location++) {
+			for (int card = 0; card < CARD_SLOTS; card++) {
+				probability[location][card] *= unseen[card];
+			}
+		}
+	}
+
+	/// <summary>
+	/// Sets card's chance of being at location to value and scales its other locations so the row still adds up to 1.
+	/// </summary>
+	void SetProbability(int location, int card, float value) {
+		float rest = 1.0f - probability[location][card];
+		float scale = rest > 1e-6f ? (1.0f - value) / rest : 0.0f;
+		for (int other = 0; other < LOCATIONS; other++) {
+			probability[other][card] *= scale;
+		}
+
+		probability[location][card] = value;
+	}
+
+	/// <summary>
+	/// player told everyone they have none of cardNumber.
+	/// </summary>
+	void HasNone(int player, int cardNumber) {
+		for (uint64_t cards = unknown & CardNumberMask(cardNumber); cards != 0; cards &= cards - 1) {
+			SetProbability(player, std::countr_zero(cards), 0.0f);
+		}
+
+		mustHold[player] &= ~(1 << cardNumber);
+	}
+
+	/// <summary>
+	/// player asked for cardNumber, so they have at least one.  Treating the cards as independent, conditioning on at least
+	///		one of them being there divides each card's chance by the chance of at least one.
+	/// </summary>
+	void HasAtLeastOne(int player, int cardNumber) {
+		mustHold[player] |= 1 << cardNumber;
+		uint64_t cards = unknown & CardNumberMask(cardNumber);
+		if ((knownAt[player] & CardNumberMask(cardNumber)) != 0 || cards == 0)
+			return;
+
+		float none = 1.0f;
+		for (uint64_t remaining = cards; remaining != 0; remaining &= remaining - 1) {
+			none *= 1.0f - probability[player][std::countr_zero(remaining)];
+		}
+
+		if (none > 1.0f - 1e-6f)
+			return;//Nothing they could have.  Only the deck's own guesses were wrong, so leave it to the fitting.
+
+		for (; cards != 0; cards &= cards - 1) {
+			int card = std::countr_zero(cards);
+			SetProbability(player, card, std::min(1.0f, probability[player][card] / (1.0f - none)));
+		}
+	}
+
+	/// <summary>
+	/// from gave all count of their unseen cards of cardNumber to to.  Conditions from's column for those cards on holding exactly
+	///		count of them, then moves that much of each card's chance from from to to.
+	/// </summary>
+	void Transfer(int from, int to, int cardNumber, int count) {
+		uint64_t cards = unknown & CardNumberMask(cardNumber);
+		float total = 0;
+		for (uint64_t remaining = cards; remaining != 0; remaining &= remaining - 1) {
+			total += probability[from][std::countr_zero(remaining)];
+		}
+
+		float scale = total > 1e-6f ? count / total : 0.0f;
+		for (; cards != 0; cards &= cards - 1) {
+			int card = std::countr_zero(cards);
+			float given = std::min(1.0f, probability[from][card] * scale);
+			SetProbability(from, card, given);
+			float toChance = probability[to][card] + given;
+			probability[from][card] = 0;
+			probability[to][card] = toChance;
+		}
+	}
+
+	/// <summary>
+	/// player drew the top card of the deck.  Every unseen card in the deck was equally likely to be on top.
+	/// </summary>
+	void Draw(int player) {
+		float share = sizes[DECK_LOCATION] > 0 ? 1.0f / sizes[DECK_LOCATION] : 0.0f;
+		for (int card = 0; card < CARD_SLOTS; card++) {
+			float moved = probability[DECK_LOCATION][card] * share;
+			probability[DECK_LOCATION][card] -= moved;
+			probability[player][card] += moved;
+		}
+
+		sizes[player]++;
+		sizes[DECK_LOCATION]--;
+	}
+
+	/// <summary>
+	/// Number of unseen cards at location, which its column should add up to.
+	/// </summary>
+	float Target(int location) const {
+		return static_cast<float>(sizes[location] - std::popcount(knownAt[location]));
+	}
+
+	/// <summary>
+	/// Iterative proportional fitting: scales each location's column to its target, then each card's row back to 1.
+	/// Column sums are kept in 8 separate partial sums, because the compiler won't reorder a float sum into SIMD lanes by
+	///		itself without -ffast-math.
+	/// </summary>
+	void Fit() {
+		alignas(64) float rowSums[CARD_SLOTS];
+		for (int pass = 0; pass < FITTING_PASSES; pass++) {
+			for (int location = 0; location < LOCATIONS; location++) {
+				float partial[8] = {};
+				for (int card = 0; card < CARD_SLOTS; card += 8) {
+					for (int lane = 0; lane < 8; lane++) {
+						partial[lane] += probability[location][card + lane];
+					}
+				}
+
+				float sum = partial[0] + partial[1] + partial[2] + partial[3] + partial[4] + partial[5] + partial[6] + partial[7];
+				float target = Target(location);
+				float scale = sum > 1e-6f ? target / sum : 0.0f;
+				for (int card = 0; card < CARD_SLOTS; card++) {
+					probability[location][card] *= scale;
+				}
+			}
+
+			std::fill(std::begin(rowSums), std::end(rowSums), 0.0f);
+			for (int location = 0; location < LOCATIONS; location++) {
+				for (int card = 0; card < CARD_SLOTS; card++) {
+					rowSums[card] += probability[location][card];
+				}
+			}
+
+			for (int card = 0; card < CARD_SLOTS; card++) {
+				rowSums[card] = unseen[card] / std::max(rowSums[card], 1e-6f);
+			}
+
+			for (int location = 0; location < LOCATIONS; location++) {
+				for (int card = 0; card < CARD_SLOTS; card++) {
+					probability[location][card] *= rowSums[card];
+				}
+			}
+		}
+	}
+
+	/// <summary>
+	/// Recomputes the cached answers for ProbabilityHolds and ExpectedCount.
+	/// </summary>
+	void UpdateQueries() {
+		for (int location = 0; location < LOCATIONS; location++) {
+			for (int cardNumber = 0; cardNumber < CARDS_PER_SUIT; cardNumber++) {
+				const float* chances = probability[location] + cardNumber * SUITS_PER_DECK;
+				int known = std::popcount(knownAt[location] & CardNumberMask(cardNumber));
+				float none = (1.0f - chances[0]) * (1.0f - chances[1]) * (1.0f - chances[2]) * (1.0f - chances[3]);
+				bool certain = known > 0 || (location < MAX_PLAYERS && (mustHold[location] >> cardNumber & 1));
+				holds[location][cardNumber] = certain ? 1.0f : 1.0f - none;
+				expected[location][cardNumber] = known + chances[0] + chances[1] + chances[2] + chances[3];
+			}
+		}
+	}
+
+public:
+	CardInference() {
+		TableView table = {};
+		table.playerCount = MIN_PLAYERS;
+		Start(table);
+	}
+
+	/// <summary>
+	/// Starts a new game seen by table.playerNumber right after the deal.  Every unseen card starts equally likely to be in each
+	///		unseen card slot.
+	/// </summary>
+	void Start(const TableView& table) {
+		observer = table.playerNumber;
+		playerCount = table.playerCount;
+		for (int location = 0; location < LOCATIONS; location++) {
+			knownAt[location] = 0;
+			mustHold[location] = 0;
+			sizes[location] = location < MAX_PLAYERS ? table.handSizes[location] : table.deckSize;
+		}
+
+		knownAt[observer] = table.hand;
+		SetUnseen(((1ull << DECK_SIZE) - 1) & ~table.hand);
+		float unseenCount = static_cast<float>(std::popcount(unknown));
+		for (int location = 0; location < LOCATIONS; location++) {
+			float chance = unseenCount > 0 ? Target(location) / unseenCount : 0.0f;
+			for (int card = 0; card < CARD_SLOTS; card++) {
+				probability[location][card] = chance * unseen[card];
+			}
+		}
+
+		UpdateQueries();
+	}
+
+	/// <summary>
+	/// Catches up with the observer's own hand and everyone's exact hand sizes.  Cards the observer drew or was given are
+	///		taken out of the matrix once they can be seen.
+	/// </summary>
+	void Sync(const TableView& table) {
+		uint64_t newCards = table.hand & ~knownAt[observer];
+		knownAt[observer] = table.hand;
+		for (int location = 0; location < MAX_PLAYERS; location++) {
+			sizes[location] = table.handSizes[location];
+			if (location != observer)
+				knownAt[location] &= ~table.hand;
+		}
+
+		sizes[DECK_LOCATION] = table.deckSize;
+		ForgetCards(newCards);
+		Fit();
+		UpdateQueries();
+	}
+
+	/// <summary>
+	/// Updates the probabilities with a resolved guess.
+	/// </summary>
+	void ObserveGuess(const Guess& guess) {
+		int asker = guess.currentPlayerNumber;
+		int target = guess.targetPlayerNumber;
+		int cardNumber = guess.card.CardNumber();
+		uint64_t numberMask = CardNumberMask(cardNumber);
+		bool fourOfAKind = guess.guessResult == GuessResultID::Success4OfAKind || guess.guessResult == GuessResultID::GoFish4OfAKind;
+
+		//With no cards, the asker can ask for anything, so the ask says nothing about their hand.
+		if (sizes[asker] > 0)
+			HasAtLeastOne(asker, cardNumber);
+
+		if (guess.guessResult == GuessResultID::Success || guess.guessResult == GuessResultID::Success4OfAKind) {
+			uint64_t knownGiven = knownAt[target] & numberMask;
+			knownAt[target] &= ~knownGiven;
+			knownAt[asker] |= knownGiven;
+			Transfer(target, asker, cardNumber, guess.numberOfCardsRecieved - std::popcount(knownGiven));
+			sizes[target] -= guess.numberOfCardsRecieved;
+			sizes[asker] += guess.numberOfCardsRecieved;
+			mustHold[target] &= ~(1 << cardNumber);
+		}
+		else {
+			HasNone(target, cardNumber);
+			if (fourOfAKind) {
+				//The card drawn was the fourth of cardNumber, which is about to be turned in.
+				sizes[asker]++;
+				sizes[DECK_LOCATION]--;
+			}
+			else {
+				Draw(asker);
+			}
+		}
+
+		if (fourOfAKind) {
+			for (int location = 0; location < LOCATIONS; location++) {
+				knownAt[location] &= ~numberMask;
+				mustHold[location] &= ~(1 << cardNumber);
+			}
+
+			sizes[asker] -= SUITS_PER_DECK;
+			ForgetCards(numberMask);
+		}
+
+		Fit();
+		UpdateQueries();
+	}
+
+	/// <summary>
+	/// Chance that location (a player number or DECK_LOCATION) holds at least one card of cardNumber.  O(1).
+	/// Treats the four cards as independent, except that what is certain (known cards and asks) is always 1.
+	/// </summary>
+	float ProbabilityHolds(int location, int cardNumber) const {
+		return holds[location][cardNumber];
+	}
+
+	/// <summary>
+	/// Expected number of cards of cardNumber at location.  O(1).
+	/// </summary>
+	float ExpectedCount(int location, int cardNumber) const {
+		return expected[location][cardNumber];
+	}
+
+	/// <summary>
+	/// Chance that the card is at location.
+	/// </summary>
+	float Probability(int location, int cardID) const {
+		if (knownAt[location] >> cardID & 1)
+			return 1.0f;
+
+		return probability[location][cardID];
+	}
+
+	int Observer() const {
+		return observer;
+	}
+};
+
+/// <summary>
+/// BayesAI picks guesses with CardInference.
+/// It makes the same sure asks as MemoryAI.  When nothing is sure, it asks for the card number it holds the most of and uses
+///		the chance of success to pick between card numbers and players, for the cost of one update per guess instead of a search.
+/// </summary>
+class BayesAI : public NPC {
+public:
+	BayesAI(const int(&FourOfAKinds)[CARDS_PER_SUIT], Random& RandomGenerator) : fourOfAKinds(FourOfAKinds), random(RandomGenerator) {}
+	const int(&fourOfAKinds)[CARDS_PER_SUIT];//The game's four of a kinds so card numbers that have been turned in aren't guessed.
+	Random& random;//The game's random number generator.  Only used to break ties.
+	CardInference inference;
+	bool started = false;
+
+	void NewGame() override {
+		started = false;
+	}
+
+	bool WatchesTable() const override {
+		return true;
+	}
+
+	void ObserveTable(const TableView& table) override {
+		if (!started) {
+			inference.Start(table);
+			started = true;
+		}
+		else {
+			inference.Sync(table);
+		}
+	}
+
+	void ObserveGuess(const Guess& guess) override {
+		if (started)
+			inference.ObserveGuess(guess);
+	}
+
+	/// <summary>
+	/// How good asking target for cardNumber looks.  Asks target is sure to have score 8 or more, the more cards expected the better.
+	/// Otherwise the card numbers playerNumber holds the most of come first, since they are closest to a four of a kind and
+	///		asking for them gives away the least, and the chance target has one breaks ties.
+	/// </summary>
+	float Score(int playerNumber, int target, int cardNumber) const {
+		float chance = inference.ProbabilityHolds(target, cardNumber);
+		if (chance >= 1.0f)
+			return 8.0f + inference.ExpectedCount(target, cardNumber);
+
+		return inference.ExpectedCount(playerNumber, cardNumber) + chance;
+	}
+
+	/// <summary>
+	/// Picks the legal move with the highest Score.  Ties are broken randomly.
+	/// </summary>
+	Guess NextGuess(const LegalMoves& moves) override {
+		if (moves.Empty())
+			return EmptyHandGuess(moves, fourOfAKinds, random);
+
+		float bestScore = -1;
+		int ties = 0;
+		Guess best;
+		for (uint32_t targets = moves.targets; targets != 0; targets &= targets - 1) {
+			int target = std::countr_zero(targets);
+			for (uint32_t numbers = moves.numbers; numbers != 0; numbers &= numbers - 1) {
+				int cardNumber = std::countr_zero(numbers);
+				float score = Score(moves.playerNumber, target, cardNumber);
+				if (score > bestScore) {
+					bestScore = score;
+					ties = 1;
+					best = Guess(target, moves.playerNumber, cardNumber);
+				}
+				else if (score == bestScore && random.NextInt(++ties) == 0) {
+					best = Guess(target, moves.playerNumber, cardNumber);
+				}
+			}
+		}
+
+		return best;
+	}
+};
\ No newline at end of file
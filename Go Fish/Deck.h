@@ -0,0 +1,146 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <array>
+#include <algorithm>
+#include <cstdint>
+#include "ConstantsAndGlobals.h"
+#include "Card.h"
+#include "Random.h"
+#include "Shuffle.h"
+
+/// <summary>
+/// Deck keeps all DECK_SIZE cards in a fixed array and draws by moving drawIndex forward, so drawing and
+///		reshuffling for the next game never allocate.
+/// cards[drawIndex] is the top of the deck.  Cards before drawIndex have already been drawn.
+/// </summary>
+class Deck {
+public:
+
+#pragma region Constructors/Properties
+
+	/// <summary>
+	/// Starts ordered and empty.  Shuffle before drawing.
+	/// </summary>
+	Deck() : drawIndex(DECK_SIZE) {
+		FillOrdered();
+	}
+
+	std::array<Card, DECK_SIZE> cards;
+	int drawIndex;
+
+#pragma endregion
+
+#pragma region Getters
+
+	/// <summary>
+	/// Gets the number of cards that haven't been drawn.
+	/// </summary>
+	int Size() const {
+		return DECK_SIZE - drawIndex;
+	}
+
+	bool Empty() const {
+		return drawIndex >= DECK_SIZE;
+	}
+
+	const Card& Top() const {
+		return cards[drawIndex];
+	}
+
+#pragma endregion
+
+#pragma region Drawing/Shuffling
+
+	/// <summary>
+	/// Removes the top card from the deck and returns it.
+	/// </summary>
+	Card Draw() {
+		return cards[drawIndex++];
+	}
+
+	/// <summary>
+	/// Removes up to num cards from the top of the deck.
+	/// </summary>
+	/// <param name="drawn">- Set to the number of cards actually drawn, which is less than num if the deck runs out.</param>
+	/// <returns>The drawn cards.  They stay in the deck's array, so they are valid until the deck is shuffled again.</returns>
+	const Card* DrawCards(int num, int& drawn) {
+		const Card* top = cards.data() + drawIndex;
+		drawn = std::min(num, Size());
+		drawIndex += drawn;
+
+		return top;
+	}
+
+	/// <summary>
+	/// Puts the cards in order, the same order as the original linked list deck (CreateListDeck).
+	/// </summary>
+	void FillOrdered() {
+		int i = 0;
+		for (int suit = 0; suit < SUITS_PER_DECK; ++suit) {
+			for (int cardNumber = 0; cardNumber < CARDS_PER_SUIT; ++cardNumber) {
+				cards[i++] = Card(cardNumber, suit);
+			}
+		}
+	}
+
+	/// <summary>
+	/// Puts every card back in the deck in order, then shuffles them in place.
+	/// Starting from the ordered deck means the result only depends on random, not on the previous game.
+	/// </summary>
+	void Shuffle(Random& random) {
+		FillOrdered();
+		FisherYatesShuffle(cards.data(), DECK_SIZE, random);
+		drawIndex = 0;
+	}
+
+	/// <summary>
+	/// Puts every card back in the deck in the order given by cardIDs instead of shuffling, e.g. to replay a logged game.
+	/// </summary>
+	void SetOrder(const uint8_t* cardIDs) {
+		for (int i = 0; i < DECK_SIZE; i++) {
+			cards[i] = Card(static_cast<int>(cardIDs[i]));
+		}
+
+		drawIndex = 0;
+	}
+
+	/// <summary>
+	/// Empties the deck without changing the order of the cards.
+	/// </summary>
+	void Clear() {
+		drawIndex = DECK_SIZE;
+	}
+
+#pragma endregion
+
+#pragma region ToString
+
+	/// <summary>
+	/// Converts the cards that haven't been drawn to a string from the top of the deck down.
+	/// </summary>
+	std::string ToString(std::string label = "") const {
+		std::string result = "";
+		if (label != "")
+			result += label + ": ";
+
+		result += "{ ";
+		for (int i = drawIndex; i < DECK_SIZE; i++) {
+			if (i > drawIndex)
+				result += ", ";
+
+			result += Card::ToString(cards[i]);
+		}
+
+		result += " }";
+
+		return result;
+	}
+
+	void Print(std::string label = "") const {
+		std::cout << ToString(label) << std::endl;
+	}
+
+#pragma endregion
+};
\ No newline at end of file
@@ -0,0 +1,225 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include "ConstantsAndGlobals.h"
+#include "linkedList.h"
+#include "Random.h"
+#include "Deck.h"
+#include "GameState.h"
+#include "GameSnapshot.h"
+#include "Simulation.h"
+#include "BigWheelSieve.h"
+#include "ShuffleBenchmark.h"
+#include "MicroBenchmark.h"
+
+#pragma region Engine Benchmarks
+
+/// <summary>
+/// Times linkedList's Add, Emplace (unsorted and sorted), Sort, Shuffle, operator[] (with and without the index) and Contains.
+/// </summary>
+void RunLinkedListBenchmarks(MicroBenchmarkSuite& suite) {
+	Random random(12345);
+	const int sizes[] = { 100, 10000 };
+	for (int size : sizes) {
+		std::string suffix = "/" + std::to_string(size);
+		std::vector<int> values(size);
+		for (int& value : values) {
+			value = random.NextInt(size * 2);
+		}
+
+		linkedList<int> list;
+		suite.Run("linkedList.Add" + suffix, size, [&] { list.Clear(); }, [&] {
+			for (int value : values) {
+				list.Add(value);
+			}
+
+			return list.Count();
+		});
+
+		suite.Run("linkedList.Emplace unsorted" + suffix, size, [&] { list.Clear(); }, [&] {
+			for (int value : values) {
+				list.Emplace(value);
+			}
+
+			return list.Count();
+		});
+
+		//Each insert walks the list, so this is O(n^2).  10000 would take most of the suite's time.
+		int sortedSize = std::min(size, 1000);
+		linkedList<int> sortedList;
+		sortedList.Sort();//Sorting an empty list makes every Emplace after it insert sorted.
+		suite.Run("linkedList.Emplace sorted/" + std::to_string(sortedSize), sortedSize, [&] { sortedList.Clear(); }, [&] {
+			for (int i = 0; i < sortedSize; i++) {
+				sortedList.Emplace(values[i]);
+			}
+
+			return sortedList.Count();
+		});
+
+		list.Clear();
+		list.AddBatch(values.data(), size);
+		suite.Run("linkedList.Sort" + suffix, size, [&] { list.Shuffle(random); }, [&] {
+			list.Sort();
+			return list.First()->value;
+		});
+
+		suite.Run("linkedList.Shuffle" + suffix, size, [&] {
+			list.Shuffle(random);
+			return list.First()->value;
+		});
+
+		const int lookups = 1000;
+		std::vector<int> indexes(lookups);
+		for (int& index : indexes) {
+			index = random.NextInt(size);
+		}
+
+		suite.Run("linkedList.operator[]" + suffix, lookups, [&] {
+			long long sum = 0;
+			for (int index : indexes) {
+				sum += list[index]->value;
+			}
+
+			return sum;
+		});
+
+		list.SetIndexed(true);
+		suite.Run("linkedList.operator[] indexed" + suffix, lookups, [&] {
+			long long sum = 0;
+			for (int index : indexes) {
+				sum += list[index]->value;
+			}
+
+			return sum;
+		});
+
+		list.SetIndexed(false);
+		list.Sort();
+		int searches = size > 1000 ? 100 : lookups;
+		suite.Run("linkedList.Contains" + suffix, searches, [&] {
+			int found = 0;
+			for (int i = 0; i < searches; i++) {
+				found += list.Contains(values[indexes[i]] + 1) ? 1 : 0;
+			}
+
+			return found;
+		});
+	}
+}
+
+/// <summary>
+/// Times making a shuffled deck with Deck and the original linkedList of Cards from CreateListDeck.
+/// </summary>
+void RunDeckBenchmarks(MicroBenchmarkSuite& suite) {
+	Random random(12345);
+	Deck deck;
+	suite.Run("Deck.Shuffle", 1, [&] {
+		deck.Shuffle(random);
+		return deck.Top().CardID;
+	});
+
+	suite.Run("CreateListDeck", 1, [&] {
+		std::unique_ptr<linkedList<Card>> cards = CreateListDeck();
+		return cards->Count();
+	});
+}
+
+/// <summary>
+/// Times UpdateGuessResult on the same position from the middle of a game with a guess that succeeds and one that goes fish.
+/// The position is restored before every guess, so Restore is timed on its own too.  Subtract it to get UpdateGuessResult alone.
+/// </summary>
+void RunUpdateGuessResultBenchmarks(MicroBenchmarkSuite& suite) {
+	GameState game;
+	game.PopulatePlayers(4, HeadlessPlayerName(0));
+	game.StartGame(GameSeed(7, 0));
+	for (int i = 0; i < 10 && !game.GameOver(); i++) {
+		Guess guess = game.GetNPCGuess();
+		game.PlayGuess(guess);
+	}
+
+	GameSnapshot position = game.Snapshot();
+	LegalMoves moves = game.GetLegalMoves();
+	Guess success;
+	Guess goFish;
+	for (int index = 0; index < moves.Count(); index++) {
+		Guess guess = moves.At(index);
+		bool held = game.players[guess.targetPlayerNumber]->value.hand.CountOfNumber(guess.card.CardNumber()) > 0;
+		(held ? success : goFish) = guess;
+	}
+
+	const int repetitions = 100;
+	suite.Run("GameState.Restore", repetitions, [&] {
+		long long sum = 0;
+		for (int i = 0; i < repetitions; i++) {
+			game.Restore(position);
+			sum += game.deck.Size();
+		}
+
+		return sum;
+	});
+
+	const Guess guesses[] = { success, goFish };
+	const std::string names[] = { "GameState.Restore + UpdateGuessResult success", "GameState.Restore + UpdateGuessResult go fish" };
+	for (int i = 0; i < 2; i++) {
+		if (guesses[i].targetPlayerNumber == -1)
+			continue;//The position doesn't have this kind of guess.
+
+		suite.Run(names[i], repetitions, [&] {
+			long long sum = 0;
+			for (int repetition = 0; repetition < repetitions; repetition++) {
+				game.Restore(position);
+				Guess guess = guesses[i];
+				game.UpdateGuessResult(guess);
+				sum += guess.guessResult;
+			}
+
+			return sum;
+		});
+	}
+}
+
+/// <summary>
+/// Times whole headless games between random NPCs.  Every sample plays the next game seed, so each run plays the same games.
+/// </summary>
+template<typename GameType>
+void RunHeadlessGameBenchmark(MicroBenchmarkSuite& suite, const std::string& hands, int numberOfPlayers) {
+	GameType game;
+	game.PopulatePlayers(numberOfPlayers, HeadlessPlayerName(0));
+	SimulationResults results(numberOfPlayers);
+	long long gameNumber = 0;
+	suite.Run("Game.Headless " + hands + "/" + std::to_string(numberOfPlayers) + " players", 1, [&] {
+		PlayHeadlessGame(game, GameSeed(8, gameNumber++), results);
+		return results.turns;
+	});
+}
+
+/// <summary>
+/// Times BigWheelSieve for several prime counts.
+/// </summary>
+void RunBigWheelSieveBenchmarks(MicroBenchmarkSuite& suite) {
+	const int sizes[] = { 100, 1000, 10000 };
+	for (int size : sizes) {
+		suite.Run("BigWheelSieve/" + std::to_string(size), 1, [&] {
+			std::shared_ptr<int[]> primes = BigWheelSieve(size);
+			return primes[size - 1];
+		});
+	}
+}
+
+/// <summary>
+/// Runs every engine benchmark.
+/// </summary>
+void RunEngineBenchmarks(MicroBenchmarkSuite& suite) {
+	RunLinkedListBenchmarks(suite);
+	RunDeckBenchmarks(suite);
+	RunUpdateGuessResultBenchmarks(suite);
+	RunHeadlessGameBenchmark<GameState>(suite, "list", 2);
+	RunHeadlessGameBenchmark<GameState>(suite, "list", 4);
+	RunHeadlessGameBenchmark<BitboardGameState>(suite, "bitboard", 2);
+	RunHeadlessGameBenchmark<BitboardGameState>(suite, "bitboard", 4);
+	RunBigWheelSieveBenchmarks(suite);
+}
+
+#pragma endregion
\ No newline at end of file
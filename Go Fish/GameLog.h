@@ -0,0 +1,243 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include "ConstantsAndGlobals.h"
+#include "Card.h"
+#include "Guess.h"
+#include "Deck.h"
+
+#pragma region Game Log Format
+
+/// <summary>
+/// Binary game log, little endian, no padding:
+/// File header (GAME_LOG_FILE_HEADER_SIZE bytes): "GOFISHLG", uint16 version, uint8 player count, uint8 0, uint64 simulation seed.
+/// Then one entry per game until the end of the file:
+///		uint64 game number (its game seed is GameSeed(simulation seed, game number)), int8 first player, uint16 guess count,
+///		GAME_LOG_DECK_SIZE bytes of deck order (6 bit CardIDs, first card in the low bits), then one LoggedGuess per guess.
+/// A game is 50 bytes plus 2 per guess, about 163 bytes for an average 2 player game.
+/// </summary>
+const char GAME_LOG_MAGIC[8] = { 'G', 'O', 'F', 'I', 'S', 'H', 'L', 'G' };
+const uint16_t GAME_LOG_VERSION = 2;//Version 1 only had 2 bits for cards received.
+const int GAME_LOG_FILE_HEADER_SIZE = 20;
+const int GAME_LOG_CARD_BITS = 6;
+const int GAME_LOG_DECK_SIZE = (DECK_SIZE * GAME_LOG_CARD_BITS + 7) / 8;
+const int GAME_LOG_GAME_HEADER_SIZE = 8 + 1 + 2 + GAME_LOG_DECK_SIZE;
+const int GAME_LOG_MAX_GUESSES = UINT16_MAX;
+
+/// <summary>
+/// One guess and its outcome in 16 bits: guessing player (3), target player (3), card number (4), GuessResultID (3) and cards
+///		received (3).  A player with no cards can ask for a card number they don't have and be given all 4, so 2 bits isn't enough.
+///		Cards received is 0 when the guess went fish, because the drawn card comes from the logged deck order.
+/// </summary>
+struct LoggedGuess {
+	uint16_t bits;
+
+	static LoggedGuess Pack(const Guess& guess) {
+		bool received = guess.guessResult == GuessResultID::Success || guess.guessResult == GuessResultID::Success4OfAKind;
+		return { static_cast<uint16_t>(guess.currentPlayerNumber | guess.targetPlayerNumber << 3 | guess.card.CardNumber() << 6 | guess.guessResult << 10
+			| (received ? guess.numberOfCardsRecieved : 0) << 13) };
+	}
+
+	int CurrentPlayerNumber() const {
+		return bits & 0x7;
+	}
+
+	int TargetPlayerNumber() const {
+		return bits >> 3 & 0x7;
+	}
+
+	int CardNumber() const {
+		return bits >> 6 & 0xF;
+	}
+
+	int GuessResult() const {
+		return bits >> 10 & 0x7;
+	}
+
+	int NumberOfCardsRecieved() const {
+		return bits >> 13 & 0x7;
+	}
+
+	/// <summary>
+	/// Gets the guess as it was asked, before it was played.
+	/// </summary>
+	Guess Question() const {
+		return Guess(TargetPlayerNumber(), CurrentPlayerNumber(), CardNumber());//Guess takes the card number and makes the card with suit 0.
+	}
+};
+
+/// <summary>
+/// Writes value to bytes, least significant byte first.
+/// </summary>
+inline void WriteLittleEndian(uint8_t* bytes, uint64_t value, int size) {
+	for (int i = 0; i < size; i++) {
+		bytes[i] = static_cast<uint8_t>(value >> (8 * i));
+	}
+}
+
+inline uint64_t ReadLittleEndian(const uint8_t* bytes, int size) {
+	uint64_t value = 0;
+	for (int i = 0; i < size; i++) {
+		value |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+	}
+
+	return value;
+}
+
+/// <summary>
+/// Packs the deck order into GAME_LOG_DECK_SIZE bytes.
+/// </summary>
+inline void PackDeckOrder(const Deck& deck, uint8_t* bytes) {
+	std::memset(bytes, 0, GAME_LOG_DECK_SIZE);
+	for (int i = 0; i < DECK_SIZE; i++) {
+		int bit = i * GAME_LOG_CARD_BITS;
+		uint32_t shifted = static_cast<uint32_t>(deck.cards[i].CardID) << (bit % 8);
+		bytes[bit / 8] |= static_cast<uint8_t>(shifted);
+		if (shifted > 0xFF)
+			bytes[bit / 8 + 1] |= static_cast<uint8_t>(shifted >> 8);
+	}
+}
+
+/// <summary>
+/// Unpacks a deck order packed by PackDeckOrder into CardIDs.
+/// </summary>
+inline void UnpackDeckOrder(const uint8_t* bytes, uint8_t* cardIDs) {
+	for (int i = 0; i < DECK_SIZE; i++) {
+		int bit = i * GAME_LOG_CARD_BITS;
+		uint32_t pair = bytes[bit / 8] | (bit / 8 + 1 < GAME_LOG_DECK_SIZE ? bytes[bit / 8 + 1] << 8 : 0);
+		cardIDs[i] = static_cast<uint8_t>(pair >> (bit % 8) & ((1 << GAME_LOG_CARD_BITS) - 1));
+	}
+}
+
+#pragma endregion
+
+#pragma region Game Log Writer
+
+/// <summary>
+/// GameLogWriter streams games to a log file.  Each game is staged until EndGame, then copied into a block buffer, and the block
+///		is written with a single unbuffered fwrite (one write call) whenever the next game doesn't fit.
+/// One writer per thread.  Simulation workers each write their own shard file.
+/// </summary>
+class GameLogWriter {
+	GameLogWriter(const GameLogWriter& other) = delete;
+
+	std::FILE* file;
+	std::unique_ptr<uint8_t[]> block;
+	size_t blockSize;
+	size_t blockUsed;
+	std::vector<uint8_t> gameBytes;//The game being logged.  Empty between games.
+	bool failed;
+
+	void WriteBlock() {
+		if (blockUsed > 0 && !failed && std::fwrite(block.get(), 1, blockUsed, file) != blockUsed)
+			failed = true;
+
+		blockUsed = 0;
+	}
+
+public:
+
+	/// <summary>
+	/// Creates path and writes the file header.  Check Ok() before logging.
+	/// </summary>
+	GameLogWriter(const std::string& path, int PlayerCount, uint64_t SimulationSeed, size_t BlockSize = 1 << 20) : file(std::fopen(path.c_str(), "wb")),
+		block(new uint8_t[BlockSize]), blockSize(BlockSize), blockUsed(0), failed(false), games(0), guesses(0), bytes(0) {
+		if (file == nullptr) {
+			failed = true;
+			return;
+		}
+
+		std::setvbuf(file, nullptr, _IONBF, 0);//The block is the buffer.
+		gameBytes.reserve(1024);
+		std::memcpy(block.get(), GAME_LOG_MAGIC, sizeof(GAME_LOG_MAGIC));
+		WriteLittleEndian(block.get() + 8, GAME_LOG_VERSION, 2);
+		block[10] = static_cast<uint8_t>(PlayerCount);
+		block[11] = 0;
+		WriteLittleEndian(block.get() + 12, SimulationSeed, 8);
+		blockUsed = GAME_LOG_FILE_HEADER_SIZE;
+		bytes = GAME_LOG_FILE_HEADER_SIZE;
+	}
+
+	~GameLogWriter() {
+		Close();
+	}
+
+	long long games;
+	long long guesses;
+	long long bytes;
+
+	bool Ok() const {
+		return !failed;
+	}
+
+	/// <summary>
+	/// Starts logging a game.  Call right after StartGame, while the deck still has its full order.
+	/// </summary>
+	template<typename GameType>
+	void BeginGame(long long gameNumber, const GameType& game) {
+		gameBytes.resize(GAME_LOG_GAME_HEADER_SIZE);
+		WriteLittleEndian(gameBytes.data(), static_cast<uint64_t>(gameNumber), 8);
+		gameBytes[8] = static_cast<uint8_t>(game.currentPlayer->value.playerNumber);
+		PackDeckOrder(game.deck, gameBytes.data() + 11);
+	}
+
+	/// <summary>
+	/// Logs a guess after it has been played.
+	/// </summary>
+	void AddGuess(const Guess& guess) {
+		uint16_t bits = LoggedGuess::Pack(guess).bits;
+		gameBytes.push_back(static_cast<uint8_t>(bits));
+		gameBytes.push_back(static_cast<uint8_t>(bits >> 8));
+	}
+
+	/// <summary>
+	/// Finishes the game and moves it into the block.  A game with more guesses than the format can count fails the log.
+	/// </summary>
+	void EndGame() {
+		size_t guessCount = (gameBytes.size() - GAME_LOG_GAME_HEADER_SIZE) / sizeof(LoggedGuess);
+		if (guessCount > GAME_LOG_MAX_GUESSES)
+			failed = true;
+
+		WriteLittleEndian(gameBytes.data() + 9, guessCount, 2);
+		if (blockUsed + gameBytes.size() > blockSize)
+			WriteBlock();
+
+		if (gameBytes.size() > blockSize) {
+			if (!failed && std::fwrite(gameBytes.data(), 1, gameBytes.size(), file) != gameBytes.size())
+				failed = true;
+		}
+		else {
+			std::memcpy(block.get() + blockUsed, gameBytes.data(), gameBytes.size());
+			blockUsed += gameBytes.size();
+		}
+
+		games++;
+		guesses += guessCount;
+		bytes += gameBytes.size();
+		gameBytes.clear();
+	}
+
+	/// <summary>
+	/// Writes whatever is left in the block and closes the file.
+	/// </summary>
+	/// <returns>False if anything failed to be written.</returns>
+	bool Close() {
+		if (file == nullptr)
+			return !failed;
+
+		WriteBlock();
+		if (std::fclose(file) != 0)
+			failed = true;
+
+		file = nullptr;
+
+		return !failed;
+	}
+};
+
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include <cstring>
+#include <cstddef>
+#include "ConstantsAndGlobals.h"
+#include "Card.h"
+#include "Guess.h"
+#include "Random.h"
+
+/// <summary>
+/// A Guess packed into 5 bytes for GameSnapshot.
+/// </summary>
+struct PackedGuess {
+	int8_t targetPlayerNumber;
+	int8_t currentPlayerNumber;
+	uint8_t cardID;
+	uint8_t guessResult;
+	int8_t numberOfCardsRecieved;
+
+	static PackedGuess Pack(const Guess& guess) {
+		return {
+			static_cast<int8_t>(guess.targetPlayerNumber),
+			static_cast<int8_t>(guess.currentPlayerNumber),
+			static_cast<uint8_t>(guess.card.CardID),
+			static_cast<uint8_t>(guess.guessResult),
+			static_cast<int8_t>(guess.numberOfCardsRecieved)
+		};
+	}
+
+	Guess Unpack() const {
+		Guess guess;
+		guess.targetPlayerNumber = targetPlayerNumber;
+		guess.currentPlayerNumber = currentPlayerNumber;
+		guess.card = Card(static_cast<int>(cardID));
+		guess.guessResult = guessResult;
+		guess.numberOfCardsRecieved = numberOfCardsRecieved;
+
+		return guess;
+	}
+};
+
+/// <summary>
+/// Everything needed to put a game back exactly how it was: every hand, the deck order and draw position, the four of a kinds,
+///		the current player, the last round of guesses and the random number generator.
+/// Trivially copyable and exactly 3 cache lines, so it can be memcpy'd, stored in bulk in a flat array, and restored in
+///		well under a microsecond into a BitboardGameState.
+/// Made with BasicGameState::SaveSnapshot and applied with BasicGameState::Restore.  Player names aren't included because
+///		the players never change during a game.
+/// </summary>
+struct alignas(64) GameSnapshot {
+	uint64_t hands[MAX_PLAYERS];//Bit CardID is set if the player has that card, indexed by player number.  Same as BitboardHand.
+	Random random;
+	uint8_t deck[DECK_SIZE];//CardIDs in deck order.  deck[drawIndex] is the top of the deck.
+	int8_t fourOfAKinds[CARDS_PER_SUIT];//Player number that turned in each card number, or NO_PLAYER.
+	uint8_t drawIndex;
+	int8_t currentPlayer;//Player number of the current player, or NO_PLAYER before the game starts.
+	uint8_t playerCount;
+	PackedGuess lastGuesses[MAX_PLAYERS];
+
+	/// <summary>
+	/// Compares every field.  Only the padding at the end is skipped.
+	/// </summary>
+	bool operator==(const GameSnapshot& other) const {
+		return std::memcmp(this, &other, offsetof(GameSnapshot, lastGuesses) + sizeof(lastGuesses)) == 0;
+	}
+
+	bool operator!=(const GameSnapshot& other) const {
+		return !(*this == other);
+	}
+};
+
+static_assert(std::is_trivially_copyable_v<GameSnapshot>, "GameSnapshot must be trivially copyable so it can be memcpy'd.");
+static_assert(sizeof(GameSnapshot) == 192, "GameSnapshot should fit in 3 cache lines.");
\ No newline at end of file
@@ -0,0 +1,492 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <type_traits>
+#include <stdexcept>
+#include "ConstantsAndGlobals.h"
+#include "linkedList.h"
+#include "Card.h"
+#include "Guess.h"
+#include "NPC.h"
+#include "Player.h"
+#include "Random.h"
+#include "Deck.h"
+#include "NodePool.h"
+#include "GameSnapshot.h"
+#include "GuessJournal.h"
+#include "LegalMoves.h"
+#include "Instrumentation.h"
+#include "Tracer.h"
+
+/// <summary>
+/// GameState owns everything about a single game of Go Fish so that any number of games can exist at the same time.
+/// Nothing in here reads or writes the console.
+/// HandType is the hand representation, either ListHand or BitboardHand.
+/// </summary>
+template<typename HandType>
+class BasicGameState {
+	BasicGameState(const BasicGameState& other) = delete;//Delete copy constructor to prevent copying GameState objects.
+
+public:
+	typedef BasicPlayer<HandType> PlayerType;
+
+#pragma region Constructors/Properties
+
+	BasicGameState() : cardPool(DECK_SIZE), players(PlayerType::ToString), currentPlayer(nullptr), seed(0), randomizer(FourOfAKinds, random) {
+		//The players never change during a game, but are looked up by player number every guess.
+		players.SetIndexed(true);
+		std::fill(std::begin(FourOfAKinds), std::end(FourOfAKinds), NO_PLAYER);
+	}
+
+	/// <summary>
+	/// Every card element in a ListHand comes from this pool.  It is reserved for the whole deck, so moving cards between
+	///		hands never calls the global allocator.  Declared before players so it is destroyed after them.
+	/// </summary>
+	NodePool<element<Card>> cardPool;
+
+	linkedList<PlayerType> players;
+	Deck deck;
+	element<PlayerType>* currentPlayer;
+	std::vector<int> Scores;//Not used until the end of the game when the scores are tallied.
+	std::vector<Guess> lastGuesses;//The last round of guesses are kept for the local player to see during their turn.
+
+	/// <summary>
+	/// The player number that turned in each four of a kind, indexed by card number.  NO_PLAYER if it hasn't been turned in.
+	/// </summary>
+	int FourOfAKinds[CARDS_PER_SUIT];
+
+	/// <summary>
+	/// Every random choice in the game (shuffling, first player and NPC guesses) comes from random, so a game started with the
+	///		same seed and players always plays out the same.
+	/// </summary>
+	Random random;
+	uint64_t seed;
+
+	/// <summary>
+	/// The NPC strategy playing each seat, set with SetNPC.  Seats without one are played by randomizer.
+	/// </summary>
+	std::unique_ptr<NPC> npcs[MAX_PLAYERS];
+	RandomizerAI randomizer;
+
+#pragma endregion
+
+#pragma region Setup
+
+	/// <summary>
+	/// Creates the players and fills Scores and lastGuesses with an entry for each of them.
+	/// </summary>
+	void PopulatePlayers(int numberOfPlayers, std::string player0Name) {
+		players.Emplace(0, player0Name);
+		for (int i = 1; i < numberOfPlayers; i++) {
+			players.Emplace(players.Count());
+		}
+
+		if constexpr (std::is_base_of_v<linkedList<Card>, HandType>) {
+			cardPool.Reserve(DECK_SIZE);
+			for (PlayerType& player : players) {
+				player.hand.SetPool(&cardPool);
+			}
+		}
+
+		Scores.assign(numberOfPlayers, 0);
+		lastGuesses.assign(numberOfPlayers, Guess());
+	}
+
+	/// <summary>
+	/// Clears everything left over from the previous game so that another game can be played with the same players.
+	/// </summary>
+	void Reset() {
+		for (PlayerType& player : players) {
+			player.hand.Clear();
+		}
+
+		deck.Clear();
+		currentPlayer = nullptr;
+		std::fill(std::begin(FourOfAKinds), std::end(FourOfAKinds), NO_PLAYER);
+		std::fill(Scores.begin(), Scores.end(), 0);
+		std::fill(lastGuesses.begin(), lastGuesses.end(), Guess());
+		for (std::unique_ptr<NPC>& npc : npcs) {
+			if (npc != nullptr)
+				npc->NewGame();
+		}
+	}
+
+	/// <summary>
+	/// Makes npc play the seat playerNumber.  nullptr gives the seat back to randomizer.
+	/// Use SetStrategy from NPCFactory.h to make one by name.
+	/// </summary>
+	void SetNPC(int playerNumber, std::unique_ptr<NPC> npc) {
+		npcs[playerNumber] = std::move(npc);
+	}
+
+	NPC& PlayerNPC(int playerNumber) {
+		return npcs[playerNumber] != nullptr ? *npcs[playerNumber] : randomizer;
+	}
+
+	void SelectFirstPlayer() {
+		currentPlayer = players[random.NextInt(players.Count())];
+	}
+
+	/// <summary>
+	/// Puts every card back in the deck and shuffles it in place.
+	/// </summary>
+	void CreateAndShuffleDeck() {
+		INSTRUMENT_PHASE(CreateAndShuffleDeck);
+		deck.Shuffle(random);
+	}
+
+	void DealOpeningHands() {
+		INSTRUMENT_PHASE(DealOpeningHands);
+		int startingCards = players.Count() > 2 ? 5 : 7;
+		for (PlayerType& player : players) {
+			playerDraw(player, startingCards);
+		}
+	}
+
+	/// <summary>
+	/// Seeds the game's random number generator.
+	/// </summary>
+	void Seed(uint64_t gameSeed) {
+		seed = gameSeed;
+		random.Seed(seed);
+	}
+
+	/// <summary>
+	/// Resets and seeds the game, then picks the first player, shuffles the deck and deals the opening hands.
+	/// NPCs that watch the table see the deal before anyone guesses.
+	/// </summary>
+	void StartGame(uint64_t gameSeed) {
+		Reset();
+		Seed(gameSeed);
+		SelectFirstPlayer();
+		CreateAndShuffleDeck();
+		DealOpeningHands();
+		for (int i = 0; i < players.Count(); i++) {
+			if (npcs[i] != nullptr && npcs[i]->WatchesTable())
+				npcs[i]->ObserveTable(GetTableView(i));
+		}
+	}
+
+	/// <summary>
+	/// Starts a game from a known deck order and first player instead of a seed, then deals the opening hands the same as
+	///		StartGame.  Used to replay logged games, which don't need the random number generator.
+	/// </summary>
+	void StartGameFromDeck(const uint8_t* cardIDs, int firstPlayer) {
+		Reset();
+		currentPlayer = players[firstPlayer];
+		deck.SetOrder(cardIDs);
+		DealOpeningHands();
+		for (int i = 0; i < players.Count(); i++) {
+			if (npcs[i] != nullptr && npcs[i]->WatchesTable())
+				npcs[i]->ObserveTable(GetTableView(i));
+		}
+	}
+
+#pragma endregion
+
+#pragma region Turns
+
+	std::string GetPlayerName(int playerNumber) {
+		return players[playerNumber]->value.name;
+	}
+
+	/// <summary>
+	/// The player draws num card(s) from the deck.
+	/// Hands keep themselves sorted, so drawing several cards at once (the opening hand) is one batch merge instead of num inserts.
+	/// </summary>
+	bool playerDraw(PlayerType& player, int num = 1) {
+		if (num == 1) {
+			player.hand.AddCard(deck.Draw());
+		}
+		else {
+			int drawn;
+			const Card* cards = deck.DrawCards(num, drawn);
+			player.hand.AddCards(cards, drawn);
+		}
+
+		return !deck.Empty();
+	}
+
+	bool GameOver() const {
+		return deck.Empty();
+	}
+
+	/// <summary>
+	/// Gets every guess the current player is allowed to make: any other player for any card number in their hand.
+	/// </summary>
+	LegalMoves GetLegalMoves() const {
+		int playerNumber = currentPlayer->value.playerNumber;
+		LegalMoves moves;
+		moves.playerNumber = playerNumber;
+		moves.targets = static_cast<uint8_t>(((1 << players.Count()) - 1) & ~(1 << playerNumber));
+		moves.numbers = currentPlayer->value.hand.HeldNumbers();
+
+		return moves;
+	}
+
+	/// <summary>
+	/// Gets what playerNumber can see of the table.
+	/// </summary>
+	TableView GetTableView(int playerNumber) const {
+		TableView table;
+		for (const PlayerType& player : players) {
+			table.handSizes[player.playerNumber] = static_cast<uint8_t>(player.hand.Count());
+			if (player.playerNumber == playerNumber)
+				table.hand = player.hand.Cards();
+		}
+
+		for (int i = players.Count(); i < MAX_PLAYERS; i++) {
+			table.handSizes[i] = 0;
+		}
+
+		table.deckSize = static_cast<uint8_t>(deck.Size());
+		table.playerCount = static_cast<uint8_t>(players.Count());
+		table.playerNumber = static_cast<int8_t>(playerNumber);
+
+		return table;
+	}
+
+	/// <summary>
+	/// Asks the NPC playing the current seat to pick one of the current player's legal guesses.
+	/// </summary>
+	Guess GetNPCGuess() {
+		INSTRUMENT_PHASE(NPCGuess);
+		int playerNumber = currentPlayer->value.playerNumber;
+		TRACE_SCOPE(NPCDecision, playerNumber);
+		NPC& npc = PlayerNPC(playerNumber);
+		if (npc.WatchesTable())
+			npc.ObserveTable(GetTableView(playerNumber));
+
+		return npc.NextGuess(GetLegalMoves());
+	}
+
+	/// <summary>
+	/// Times and traces ResolveGuess.
+	/// </summary>
+	void UpdateGuessResult(Guess& guess) {
+		INSTRUMENT_PHASE(UpdateGuessResult);
+		TRACE_SCOPE(ResolveGuess, guess.currentPlayerNumber);
+		ResolveGuess(guess);
+	}
+
+	/// <summary>
+	/// Plays the guess: moves the cards or draws one, turns in a four of a kind and passes the turn if the guess went fish.
+	/// Isn't timed or traced, so search playouts, which resolve millions of guesses, don't pay for it or flood the trace.
+	/// </summary>
+	void ResolveGuess(Guess& guess) {
+		//Check if the guess is correct.
+
+		int currentPlayerNumber = guess.currentPlayerNumber;
+		int guessedCardNumber = guess.card.CardNumber();
+
+		//"Give" all of the guessed cards to the current player.
+		int transfered = players[guess.targetPlayerNumber]->value.hand.GiveAllOfNumber(guessedCardNumber, players[currentPlayerNumber]->value.hand);
+		if (transfered > 0) {
+			guess.guessResult = GuessResultID::Success;
+			guess.numberOfCardsRecieved = transfered;
+		}
+		else {
+			//The other player doesn't have any 3's (or whatever the guessed card number was)
+			guess.guessResult = GuessResultID::FailGoFish;
+			playerDraw(currentPlayer->value);
+		}
+
+		//Check if the player has four of a kind.
+		HandType& hand = currentPlayer->value.hand;
+		if (hand.CountOfNumber(guessedCardNumber) == SUITS_PER_DECK) {
+			//4 of a kind, update the four of a kind array and remove the cards from the players hand.
+			guess.guessResult = guess.guessResult == GuessResultID::Success ? GuessResultID::Success4OfAKind : GuessResultID::GoFish4OfAKind;
+			FourOfAKinds[guessedCardNumber] = currentPlayerNumber;
+			hand.RemoveAllOfNumber(guessedCardNumber);
+		}
+
+		//If the player guessed wrong, it is the next players turn.
+		if (guess.guessResult == GuessResultID::FailGoFish) {
+			element<PlayerType>::Inc(currentPlayer);
+			if (currentPlayer->IsEnd())
+				currentPlayer = players.First();
+		}
+	}
+
+	/// <summary>
+	/// Resolves the guess, records it as the guessing player's last guess, then shows it to every NPC.
+	/// </summary>
+	void PlayGuess(Guess& guess) {
+		int currentPlayerNumber = guess.currentPlayerNumber;
+		UpdateGuessResult(guess);
+		lastGuesses[currentPlayerNumber] = guess;
+		for (int i = 0; i < players.Count(); i++) {
+			if (npcs[i] != nullptr)
+				npcs[i]->ObserveGuess(guess);
+		}
+	}
+
+	/// <summary>
+	/// Counts the number of 4 of a kinds each player has into Scores and returns the player number(s) with the highest score.
+	/// </summary>
+	std::vector<int> TallyScores() {
+		//Count the number of 4 of a kinds each player has.
+		for (const int& playerScoreNumber : FourOfAKinds) {
+			if (playerScoreNumber == NO_PLAYER)
+				continue;
+
+			Scores[playerScoreNumber]++;
+		}
+
+		//Use a vector for winners in case of a tie.
+		int highestScore = Scores[0];
+		std::vector<int> winners = { 0 };
+		for (int i = 1; i < static_cast<int>(Scores.size()); i++) {
+			if (Scores[i] > highestScore) {
+				highestScore = Scores[i];
+				winners.clear();
+				winners.push_back(i);
+			}
+			else if (Scores[i] == highestScore) {
+				winners.push_back(i);
+			}
+		}
+
+		return winners;
+	}
+
+#pragma endregion
+
+#pragma region Snapshots
+
+	/// <summary>
+	/// Copies the whole position into snapshot.
+	/// </summary>
+	void SaveSnapshot(GameSnapshot& snapshot) const {
+		for (const PlayerType& player : players) {
+			snapshot.hands[player.playerNumber] = player.hand.Cards();
+		}
+
+		for (int i = players.Count(); i < MAX_PLAYERS; i++) {
+			snapshot.hands[i] = 0;
+		}
+
+		snapshot.random = random;
+		for (int i = 0; i < DECK_SIZE; i++) {
+			snapshot.deck[i] = static_cast<uint8_t>(deck.cards[i].CardID);
+		}
+
+		for (int i = 0; i < CARDS_PER_SUIT; i++) {
+			snapshot.fourOfAKinds[i] = static_cast<int8_t>(FourOfAKinds[i]);
+		}
+
+		snapshot.drawIndex = static_cast<uint8_t>(deck.drawIndex);
+		snapshot.currentPlayer = static_cast<int8_t>(currentPlayer == nullptr ? NO_PLAYER : currentPlayer->value.playerNumber);
+		snapshot.playerCount = static_cast<uint8_t>(players.Count());
+		for (int i = 0; i < MAX_PLAYERS; i++) {
+			snapshot.lastGuesses[i] = PackedGuess::Pack(i < static_cast<int>(lastGuesses.size()) ? lastGuesses[i] : Guess());
+		}
+	}
+
+	GameSnapshot Snapshot() const {
+		GameSnapshot snapshot;
+		SaveSnapshot(snapshot);
+
+		return snapshot;
+	}
+
+	/// <summary>
+	/// Puts the game back to the position in snapshot.  The game must have the same number of players as the game the snapshot was taken from.
+	/// Doesn't allocate.  Scores are cleared because they are only tallied at the end of the game.
+	/// </summary>
+	void Restore(const GameSnapshot& snapshot) {
+		if (snapshot.playerCount != players.Count())
+			throw std::logic_error("Snapshot has " + std::to_string(snapshot.playerCount) + " players, but the game has " + std::to_string(players.Count()) + ".");
+
+		for (PlayerType& player : players) {
+			player.hand.SetCards(snapshot.hands[player.playerNumber]);
+		}
+
+		random = snapshot.random;
+		for (int i = 0; i < DECK_SIZE; i++) {
+			deck.cards[i] = Card(static_cast<int>(snapshot.deck[i]));
+		}
+
+		for (int i = 0; i < CARDS_PER_SUIT; i++) {
+			FourOfAKinds[i] = snapshot.fourOfAKinds[i];
+		}
+
+		deck.drawIndex = snapshot.drawIndex;
+		currentPlayer = snapshot.currentPlayer == NO_PLAYER ? nullptr : players[snapshot.currentPlayer];
+		for (int i = 0; i < static_cast<int>(lastGuesses.size()); i++) {
+			lastGuesses[i] = snapshot.lastGuesses[i].Unpack();
+		}
+
+		std::fill(Scores.begin(), Scores.end(), 0);
+	}
+
+#pragma endregion
+
+#pragma region Make/Unmake
+
+	/// <summary>
+	/// Plays the guess the same as PlayGuess, and pushes what it changed onto journal so UnmakeGuess can undo it.
+	/// Nothing is copied or allocated, so search can play and undo lines in place instead of copying the game for each node.
+	/// NPCs aren't shown made guesses because what they remember can't be unmade.
+	/// </summary>
+	void MakeGuess(Guess& guess, GuessJournal& journal) {
+		int guessedCardNumber = guess.card.CardNumber();
+		GuessDelta delta;
+		delta.movedCards = players[guess.targetPlayerNumber]->value.hand.CardsOfNumber(guessedCardNumber);
+		delta.targetPlayerNumber = static_cast<int8_t>(guess.targetPlayerNumber);
+		delta.guessingPlayerNumber = static_cast<int8_t>(guess.currentPlayerNumber);
+		delta.previousCurrentPlayer = static_cast<int8_t>(currentPlayer->value.playerNumber);
+		delta.previousLastGuess = PackedGuess::Pack(lastGuesses[guess.currentPlayerNumber]);
+		int drawIndex = deck.drawIndex;
+
+		ResolveGuess(guess);
+		lastGuesses[guess.currentPlayerNumber] = guess;
+
+		delta.drawnCard = static_cast<int8_t>(deck.drawIndex != drawIndex ? deck.cards[drawIndex].CardID : -1);
+		bool fourOfAKind = guess.guessResult == GuessResultID::Success4OfAKind || guess.guessResult == GuessResultID::GoFish4OfAKind;
+		delta.fourOfAKindNumber = static_cast<int8_t>(fourOfAKind ? guessedCardNumber : -1);
+		journal.Push(delta);
+	}
+
+	/// <summary>
+	/// Undoes the last guess made with MakeGuess.  Changes are undone in the opposite order they were made:
+	///		four of a kind, then the drawn card, then the cards given.
+	/// Random isn't part of resolving a guess, so anything drawn from it (like NPC guesses) isn't undone.
+	/// </summary>
+	void UnmakeGuess(GuessJournal& journal) {
+		GuessDelta delta = journal.Pop();
+		HandType& hand = players[delta.guessingPlayerNumber]->value.hand;
+		if (delta.fourOfAKindNumber != -1) {
+			FourOfAKinds[delta.fourOfAKindNumber] = NO_PLAYER;
+			for (int suit = 0; suit < SUITS_PER_DECK; suit++) {
+				hand.AddCard(Card(delta.fourOfAKindNumber, suit));
+			}
+		}
+
+		if (delta.drawnCard != -1) {
+			hand.RemoveCards(1ull << delta.drawnCard);
+			deck.drawIndex--;
+		}
+
+		hand.GiveCards(delta.movedCards, players[delta.targetPlayerNumber]->value.hand);
+		currentPlayer = players[delta.previousCurrentPlayer];
+		lastGuesses[delta.guessingPlayerNumber] = delta.previousLastGuess.Unpack();
+	}
+
+	/// <summary>
+	/// Undoes guesses until journal is back to depth.  O(guesses undone).
+	/// </summary>
+	void UnmakeTo(GuessJournal& journal, int depth) {
+		while (journal.Depth() > depth) {
+			UnmakeGuess(journal);
+		}
+	}
+
+#pragma endregion
+};
+
+typedef BasicGameState<ListHand> GameState;
+typedef BasicGameState<BitboardHand> BitboardGameState;
\ No newline at end of file
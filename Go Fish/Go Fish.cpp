@@ -10,58 +10,39 @@
 #include <sstream>
 #include <map>
 #include <stack>
+#include <ctime>
 #include "linkedList.h"
 #include "ConstantsAndGlobals.h"
 #include "Card.h"
 #include "Guess.h"
 #include "NPC.h"
+#include "NPCFactory.h"
 #include "Player.h"
 #include "PlayerInput.h"
+#include "GameState.h"
+#include "Simulation.h"
+#include "ShuffleBenchmark.h"
+#include "IndexBenchmark.h"
+#include "IteratorBenchmark.h"
+#include "SortBenchmark.h"
+#include "SnapshotBenchmark.h"
+#include "ISMCTSBenchmark.h"
+#include "InferenceBenchmark.h"
+#include "Tournament.h"
+#include "Tracer.h"
+#include "Replay.h"
 
 bool testing = true;//If true, you will not be prompted for you name to save time while testing.
 bool autoGuess = true;//If true, your turns will be replaced with automatic guesses to save time while testing.
 
-std::vector<Guess> lastGuesses;//The last round of guesses are kept for the local player to see during their turn.
-linkedList<Player> players(Player::ToString);
-std::stack<Card> deck;
-element<Player>* currentPlayer;
-std::vector<int> Scores;//Not used until the end of the game when the scores are tallied.
+GameState game;//The console game.  The headless simulation creates its own GameStates.
 
 /// <summary>
 /// Gets the player number.  Passed to Guess for printing the result of the guess.
 /// This helps minimize circular dependencies.
 /// </summary>
 std::string GetPlayerName(int playerNumber) {
-	return players[playerNumber]->value.name;
-}
-
-/// <summary>
-/// Creates a linked list of cards that are ordered.
-/// </summary>
-std::unique_ptr<linkedList<Card>> createDeck() {
-	std::unique_ptr <linkedList<Card>> deck = std::make_unique<linkedList<Card>>(Card::ToString);
-    for (int i = 0; i < SUITS_PER_DECK; ++i) {
-        for (int j = 0; j < CARDS_PER_SUIT; ++j) {
-            deck->Emplace(j, i);
-        }
-    }
-
-    return deck;
-};
-
-/// <summary>
-/// The player draws num card(s) from the deck.
-/// </summary
-bool playerDraw(Player& player, std::stack<Card>& deck, int num = 1) {
-    for (int i = 0; i < num; i++) {
-		Card card = deck.top();
-		player.hand.Emplace(card);
-		deck.pop();
-    }
-
-	player.hand.Sort();
-
-	return deck.size() > 0;
+	return game.GetPlayerName(playerNumber);
 }
 
 int GetNumberOfPlayers() {
@@ -86,23 +67,11 @@ std::string GetLocalPlayerName() {
 	return player0Name;
 }
 
-void PopulatePlayersAndScores(int numberOfPlayers, std::string player0Name) {
-	players.Emplace(0, player0Name);
-	Scores = { 0 };
-	for (int i = 1; i < numberOfPlayers; i++) {
-		players.Emplace(players.Count());
-		Scores.push_back(0);
-	}
-}
-
 void PrintPlayers() {
-	bool first = true;
-	for (element<Player>* player = players.First()->nextElement; !player->IsEnd(); element<Player>::Inc(player)) {
-		if (first) {
-			first = false;
-		}
-		else {
-			if (player->IsLast()) {
+	//The local player is first, so start from the second player.
+	for (auto player = std::next(game.players.begin()); player != game.players.end(); ++player) {
+		if (player != std::next(game.players.begin())) {
+			if (std::next(player) == game.players.end()) {
 				std::cout << " and ";
 			}
 			else {
@@ -110,72 +79,46 @@ void PrintPlayers() {
 			}
 		}
 
-		std::cout << player->value.name;
+		std::cout << player->name;
 	}
 
-	std::cout << " " << (players.Count() > 2 ? "have" : "has") << " joined the game.\n\n";
+	std::cout << " " << (game.players.Count() > 2 ? "have" : "has") << " joined the game.\n\n";
 }
 
 void SelectFirstPlayer() {
-	currentPlayer = players[std::rand() % players.Count()];
-	std::cout << currentPlayer->value.name << " is up first.\n\n";
-}
-
-void CreateAndShuffleDeck() {
-	std::unique_ptr<linkedList<Card>> deckList = createDeck();
-	deckList->Shuffle();
-	deck = deckList->ToStack();
-}
-
-void DealOpeningHands() {
-	int startingCards = players.Count() > 2 ? 5 : 7;
-	for (element<Player>* player = players.First(); !player->IsEnd(); element<Player>::Inc(player)) {
-		playerDraw(player->value, deck, startingCards);
-	}
+	game.SelectFirstPlayer();
+	std::cout << game.currentPlayer->value.name << " is up first.\n\n";
 }
 
 void PrintHandsAndDeck() {
-	for (element<Player>* player = players.First(); !player->IsEnd(); element<Player>::Inc(player)) {
-		player->value.hand.Print(player->value.name + " hand (" + std::to_string(player->value.hand.Count()) + ")");
+	for (Player& player : game.players) {
+		player.hand.Print(player.name + " hand (" + std::to_string(player.hand.Count()) + ")");
 	}
 
 	std::cout << std::endl;
 
-	std::stack<Card> deckCopy = deck;
-	std::cout << "Deck (" << deckCopy.size() << "): ";
-	while (!deckCopy.empty()) {
-		std::cout << Card::ToString(deckCopy.top()) << " ";
-		deckCopy.pop();
-	}
-}
-
-void SetupLastGuesses() {
-	//Fill guesses vector with empty guesses for each player.
-	for (int i = 0; i < players.Count(); i++) {
-		lastGuesses.emplace_back();
-	}
+	game.deck.Print("Deck (" + std::to_string(game.deck.Size()) + ")");
 }
 
 void Setup() {
 	//Seed the random number generator with the current time.
-	std::srand(static_cast<unsigned int>(std::time(nullptr)));
+	game.Seed(static_cast<uint64_t>(std::time(nullptr)));
 
 	int numberOfPlayers = GetNumberOfPlayers();
 	std::string player0Name = GetLocalPlayerName();
-	PopulatePlayersAndScores(numberOfPlayers, player0Name);
+	game.PopulatePlayers(numberOfPlayers, player0Name);
 	PrintPlayers();
 	SelectFirstPlayer();
-	CreateAndShuffleDeck();
+	game.CreateAndShuffleDeck();
+	game.DealOpeningHands();
 
 	bool printHandsAndDeck = false;
 	if (printHandsAndDeck)
 		PrintHandsAndDeck();//For testing
-
-	SetupLastGuesses();
 }
 
 void PrintLocalPlayersHand() {
-	currentPlayer->value.hand.Print("Your hand");
+	game.currentPlayer->value.hand.Print("Your hand");
 	std::cout << std::endl;
 }
 
@@ -183,7 +126,7 @@ void PrintFourOfAKinds() {
 	bool atLeastOneFourOfAKind = false;
 	//Check if any for of a kinds have been turned in.
 	for (int i = 0; i < CARDS_PER_SUIT; i++) {
-		if (FourOfAKinds[i] != NO_PLAYER) {
+		if (game.FourOfAKinds[i] != NO_PLAYER) {
 			atLeastOneFourOfAKind = true;
 			break;
 		}
@@ -202,25 +145,25 @@ void PrintFourOfAKinds() {
 
 	//Create the empty vectors
 	std::vector<std::vector<int>> fourOfAKinds;
-	for (int i = 0; i < players.Count(); i++) {
+	for (int i = 0; i < game.players.Count(); i++) {
 		fourOfAKinds.emplace_back();
 	}
 
 	//Fill the vectors
 	for (int i = 0; i < CARDS_PER_SUIT; i++) {
-		int playerNumber = FourOfAKinds[i];
+		int playerNumber = game.FourOfAKinds[i];
 		if (playerNumber != NO_PLAYER)
 			fourOfAKinds[playerNumber].push_back(i);
 	}
 
 	//Print the vectors
-	for (int i = 0; i < fourOfAKinds.size(); i++) {
+	for (int i = 0; i < static_cast<int>(fourOfAKinds.size()); i++) {
 		const std::vector<int>& playerFourOfAKind = fourOfAKinds[i];
 		int size = playerFourOfAKind.size();
 		if (size < 1)
 			continue;
 
-		std::cout << players[i]->value.name << ": ";
+		std::cout << game.players[i]->value.name << ": ";
 		bool first = true;
 		for (int j = 0; j < size; j++) {
 			if (first) {
@@ -244,8 +187,8 @@ void PrintFourOfAKinds() {
 
 void PrintLastRoundOfGuesses() {
 	std::cout << "Last round of guesses:\n";
-	for (int i = 0; i < lastGuesses.size(); i++) {
-		const Guess& guess = lastGuesses[i];
+	for (int i = 0; i < static_cast<int>(game.lastGuesses.size()); i++) {
+		const Guess& guess = game.lastGuesses[i];
 		if (guess.targetPlayerNumber == NO_PLAYER)
 			continue;
 
@@ -256,27 +199,33 @@ void PrintLastRoundOfGuesses() {
 }
 
 Guess GetNPCGuess() {
-	//Use RandomizerAI to get a guess for another player and card number that hasn't been turned in as a four of a kind.
-	RandomizerAI randomizer(currentPlayer->value.playerNumber, players.Count());
-
-	return randomizer.NextGuess();
+	return game.GetNPCGuess();
 }
 
 Guess GetPlayerGuess() {
 	//Prompt the local player for another player and card number.
 	int targetPlayerNumber = 1;
-	if (players.Count() > 2) {
-		std::string prompt = "What player would you like to guess? (2 - " + std::to_string(players.Count()) + ")";
-		int targetPlayerNumber = get_integer_input_in_range(prompt, 2, players.Count()) - 1;
+	if (game.players.Count() > 2) {
+		std::string prompt = "What player would you like to guess? (2 - " + std::to_string(game.players.Count()) + ")";
+		targetPlayerNumber = get_integer_input_in_range(prompt, 2, game.players.Count()) - 1;
 		std::cout << std::endl;
 	}
 
-	std::string cardPrompt = "What card would you like to guess?";
-	std::cout << cardPrompt << std::endl;
-	int cardNumber = get_option(cardDisaplayNames);
-	std::cout << std::endl;
+	//Only card numbers in your hand can be asked for.  With an empty hand, any guess is allowed so you can go fish.
+	LegalMoves moves = game.GetLegalMoves();
+	int cardNumber;
+	while (true) {
+		std::string cardPrompt = "What card would you like to guess?";
+		std::cout << cardPrompt << std::endl;
+		cardNumber = get_option(cardDisaplayNames);
+		std::cout << std::endl;
+		if (moves.Empty() || moves.Contains(targetPlayerNumber, cardNumber))
+			break;
+
+		std::cout << "You can only ask for a card you have.\n";
+	}
 
-	return Guess(targetPlayerNumber, currentPlayer->value.playerNumber, cardNumber);
+	return Guess(targetPlayerNumber, game.currentPlayer->value.playerNumber, cardNumber);
 }
 
 void Quit() {
@@ -305,136 +254,43 @@ Guess PlayerOptions() {
 	}
 }
 
-void UpdateGuessResult(Guess& guess) {
-	//Check if the guess is correct.
-
-	int currentPlayerNumber = guess.currentPlayerNumber;
-
-	//lowestCardOfNumber is used because it minimizes the amount of searching through a players hand because the result will always be the first card of the number.
-	//Example: If the guessed card number is 3, then the lowest card number will be 8 because 3's are 8, 9, 10, and 11, 
-	//	so the insert index will land at the index of the first 3 in the hand if any.  After that, increment to the right/up until no more 3's are found.
-	// 
-	//Do you have any 3's?
-	//Other players hand { 0, 3, 7, 8, 10, 11, 12, 51 }
-	//                   { A, A, 2, 3,  3,  3,  4,  K }
-	Card lowestCardOfNumber(guess.card.CardNumber(), 0);//lowestCardOfNumber = 12
-	element<Card>* card = players[guess.targetPlayerNumber]->value.hand.FindInsertElement(lowestCardOfNumber, false);//card = 8 (3 of Spades)
-	int guessedCardNumber = guess.card.CardNumber();//guessedCardNumber = 3
-	if (!card->IsEnd() && card->value.CardNumber() == guessedCardNumber) {//not the end of the list and card number (3) == guessedCardNumber (3)
-		guess.guessResult = GuessResultID::Success;
-		int transfered = 0;
-		element<Card>::Inc(card);//Because the cards will be removed, the card is incremented and the previous card is removed.  card = 10 (3 of Clubs)
-		while (card->Prev().CardNumber() == guessedCardNumber) {//previous card number 8 (3 of Spades) == guessedCardNumber (3)
-			transfered++;
-			int cardID = card->Prev().CardID;
-			//"Give" the card to the current player.
-			players[currentPlayerNumber]->value.hand.Emplace(cardID);//Create the card in asking players hand.
-			card->previousElement->Remove();//Remove the card from player being asked's hand.
-
-			//In the linkedList, there is a dummy element (the end) that helps with iterating through the list.
-			//If the current card (which is still leading the one being looked at by 1) is the end, the card being looked at is the last in the hand, so stop.
-			if (card->IsEnd())
-				break;
-
-			element<Card>::Inc(card);
-		}
-
-		guess.numberOfCardsRecieved = transfered;
+/// <summary>
+/// Plays one turn for the current player.
+/// </summary>
+void CurrentPlayerTurn() {
+	TRACE_SCOPE(Turn, game.currentPlayer->value.playerNumber);
+	Guess guess;
+	if (game.currentPlayer->value.playerNumber == LOCAL_PLAYER_NUMBER) {
+		INSTRUMENT_PHASE(PlayerGuess);
+		guess = PlayerOptions();
 	}
 	else {
-		//The other player doesn't have any 3's (or whatever the guessed card number was)
-		guess.guessResult = GuessResultID::FailGoFish;
-		playerDraw(currentPlayer->value, deck);
-	}
-
-	//Check if the player has four of a kind.
-	element<Card>* playersCard = currentPlayer->value.hand.FindInsertElement(lowestCardOfNumber, false);
-	if (playersCard->value.CardNumber() == guessedCardNumber) {
-		//Count the number of cards with the guessed card number.
-		int count = 0;
-		element<Card>::Inc(playersCard);
-		//Like before, start at the next element and look at the previous card to see if it matches the number.
-		//Not required to do it this way this time because cards aren't being removed, but it was easy to copy/paste something that was already working.
-		while (playersCard->Prev().CardNumber() == guessedCardNumber) {
-			count++;
-			if (playersCard->IsEnd())
-				break;
-
-			element<Card>::Inc(playersCard);
-		}
-
-		//4 of a kind, update the four of a kind array and remove the cards from the players hand.
-		if (count == SUITS_PER_DECK) {
-			//Remove all of the cards of the 4 of a kind number from the players hand.
-			element<Card>::Dec(playersCard);
-			guess.guessResult = guess.guessResult == GuessResultID::Success ? GuessResultID::Success4OfAKind : GuessResultID::GoFish4OfAKind;
-			FourOfAKinds[guessedCardNumber] = currentPlayerNumber;
-			while (!playersCard->IsFirst() && playersCard->Prev().CardNumber() == guessedCardNumber) {
-				//Since the hand is sorted and the cards are all being removed, the playersCard doesn't need to be incremented as removing the previous 
-				playersCard->previousElement->Remove();
-			}
-		}
-	}
-
-	//If the player guessed wrong, it is the next players turn.
-	if (guess.guessResult == GuessResultID::FailGoFish) {
-		element<Player>::Inc(currentPlayer);
-		if (currentPlayer->IsEnd())
-			currentPlayer = players.First();
+		guess = GetNPCGuess();
 	}
-}
-
-void CurrentPlayerTurn() {
-	int currentPlayerNumber = currentPlayer->value.playerNumber;
-	Guess guess = currentPlayer->value.playerNumber == LOCAL_PLAYER_NUMBER ? PlayerOptions() : GetNPCGuess();
 
 	guess.PrintGuess(GetPlayerName);
 
-	UpdateGuessResult(guess);
+	game.PlayGuess(guess);
 
 	guess.PrintResult(GetPlayerName);
-
-	lastGuesses[currentPlayerNumber] = guess;
-
-	if (deck.size() > 0)
-		CurrentPlayerTurn();
 }
 
 void EndGame() {
+	INSTRUMENT_PHASE(EndGame);
 	std::cout << "Game Over!\n";
 	std::cout << "Final Scores:\n";
 
-	//Count the number of 4 of a kinds each player has.
-	for (const int& playerScoreNumber : FourOfAKinds) {
-		if (playerScoreNumber == NO_PLAYER)
-			continue;
-
-		Scores[playerScoreNumber]++;
-	}
-
-	//Use a vector for winners in case of a tie.
-	int highestScore = Scores[0];
-	std::vector<int> winners = { 0 };
-	for (int i = 1; i < Scores.size(); i++) {
-		if (Scores[i] > highestScore) {
-			highestScore = Scores[i];
-			winners.clear();
-			winners.push_back(i);
-		}
-		else if (Scores[i] == highestScore) {
-			winners.push_back(i);
-		}
-	}
+	std::vector<int> winners = game.TallyScores();
 
 	//Print the scores.
-	for (element<Player>* player = players.First(); !player->IsEnd(); element<Player>::Inc(player)) {
-		std::cout << player->value.name << ": " << Scores[player->value.playerNumber] << std::endl;
+	for (const Player& player : game.players) {
+		std::cout << player.name << ": " << game.Scores[player.playerNumber] << std::endl;
 	}
 
 	//Print the winner(s).
 	std::cout << std::endl;
 	if (winners.size() == 1) {
-		std::cout << "Congratulations " << players[winners[0]]->value.name << ", you are the winner!\n";
+		std::cout << "Congratulations " << game.players[winners[0]]->value.name << ", you are the winner!\n";
 	}
 	else {
 		std::cout << "We have a draw! The winners are: ";
@@ -453,7 +309,7 @@ void EndGame() {
 				}
 			}
 
-			std::cout << players[winners[i]]->value.name;
+			std::cout << game.players[winners[i]]->value.name;
 		}
 	}
 	
@@ -463,13 +319,195 @@ void EndGame() {
 void GoFish() {
 	Setup();
 
-	CurrentPlayerTurn();
+	while (!game.GameOver()) {
+		CurrentPlayerTurn();
+	}
 
 	EndGame();
 }
 
-int main() {
-	GoFish();
+#pragma region Command Line
+
+/// <summary>
+/// Reads the command line options.  Returns false if they are invalid.
+/// --simulate              Run the headless simulation instead of the console game.
+/// --tournament            Play every pair of strategies (--strategies, or all of them) against each other at every player count
+///                         (or only --players) in every seat arrangement, up to --games games per matchup, and print the statistics.
+/// --bench-shuffle         Time the shuffles and check that they are uniform instead of playing.
+/// --bench-index           Time linkedList::operator[] with and without the index instead of playing.
+/// --bench-iterators       Time loops, std algorithms and parallel algorithms over linkedLists instead of playing.
+/// --bench-sort            Time linkedList::Sort and AddBatch against the insertion sort instead of playing.
+/// --bench-snapshot        Time and check GameSnapshot save/restore and MakeGuess/UnmakeGuess instead of playing.
+/// --bench-ismcts          Time ISMCTSAI playouts per second and move latency instead of playing.
+/// --bench-inference       Time CardInference updates and score its probabilities against the real hands instead of playing.
+/// --games (count)         Number of games to simulate.  The most games per matchup for --tournament.
+/// --players (count)       Number of players in each game (2 - 6).
+/// --threads (count)       Number of threads to play games on.  Defaults to one per hardware thread.
+/// --seed (value)          64 bit seed for the simulation.  Defaults to the current time.
+/// --replay-game (number)  Only play game number (number) of the simulation and print every guess.
+/// --hand (list|bitboard)  Hand representation used by the simulation.  Defaults to list.
+/// --strategies (a,b,...)  NPC strategy for each seat from player 0, separated by commas (random, memory, ismcts or bayes).  Defaults to random.
+/// --ismcts-iterations (n) Playouts per move for ismcts seats.  0 for no limit.  Defaults to 2000.
+/// --ismcts-ms (ms)        Time limit per move for ismcts seats.  0 (the default) for no limit.
+/// --ismcts-threads (n)    Threads each ismcts seat searches with.  Defaults to 1.
+/// --ismcts-confidence (z) Play MemoryAI's move unless the search's best move beats it by z standard errors.  0 (the default) always plays the search's move.
+/// --trace (path)          Trace games, turns, NPC decisions and guess resolutions on every thread and write them to (path) as
+///                         Chrome trace JSON for chrome://tracing or ui.perfetto.dev.
+/// --trace-buffer (n)      Most recent trace events kept per thread.  Defaults to 1048576 (32 MB per thread).
+/// --log (path)            Write every simulated game to a binary game log (see GameLog.h).  Each thread writes its own shard,
+///                         (path).0, (path).1 and so on.
+/// --replay-log (path)     Replay every game in the game log at (path), or its shards (path).0, (path).1 and so on, through the
+///                         rules on --threads threads and report the first game that doesn't match its log.  Exits with 1 if any don't.
+/// </summary>
+bool ParseOptions(int argc, char* argv[], SimulationOptions& options) {
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		bool hasValue = i + 1 < argc && is_integer(argv[i + 1]);
+		if (arg == "--simulate") {
+			options.simulate = true;
+		}
+		else if (arg == "--tournament") {
+			options.tournament = true;
+		}
+		else if (arg == "--bench-shuffle") {
+			options.benchmark = "shuffle";
+		}
+		else if (arg == "--bench-index") {
+			options.benchmark = "index";
+		}
+		else if (arg == "--bench-iterators") {
+			options.benchmark = "iterators";
+		}
+		else if (arg == "--bench-sort") {
+			options.benchmark = "sort";
+		}
+		else if (arg == "--bench-snapshot") {
+			options.benchmark = "snapshot";
+		}
+		else if (arg == "--bench-ismcts") {
+			options.benchmark = "ismcts";
+		}
+		else if (arg == "--bench-inference") {
+			options.benchmark = "inference";
+		}
+		else if (arg == "--games" && hasValue) {
+			options.games = std::stoll(argv[++i]);
+		}
+		else if (arg == "--players" && hasValue) {
+			options.numberOfPlayers = std::stoi(argv[++i]);
+			options.fixedPlayerCount = true;
+		}
+		else if (arg == "--threads" && hasValue) {
+			options.threads = std::stoi(argv[++i]);
+		}
+		else if (arg == "--hand" && i + 1 < argc && (std::string(argv[i + 1]) == "list" || std::string(argv[i + 1]) == "bitboard")) {
+			options.bitboardHands = std::string(argv[++i]) == "bitboard";
+		}
+		else if (arg == "--replay-game" && hasValue) {
+			options.replayGame = std::stoll(argv[++i]);
+		}
+		else if (arg == "--seed" && hasValue) {
+			options.seed = std::stoull(argv[++i]);
+		}
+		else if (arg == "--strategies" && i + 1 < argc) {
+			std::stringstream strategies(argv[++i]);
+			std::string strategy;
+			while (std::getline(strategies, strategy, ',')) {
+				if (std::find(std::begin(NPC_STRATEGIES), std::end(NPC_STRATEGIES), strategy) == std::end(NPC_STRATEGIES)) {
+					std::cout << "Unknown strategy: " << strategy << "\n";
+					return false;
+				}
+
+				options.strategies.push_back(strategy);
+			}
+		}
+		else if (arg == "--ismcts-iterations" && hasValue) {
+			options.ismcts.iterations = std::stoi(argv[++i]);
+		}
+		else if (arg == "--ismcts-ms" && hasValue) {
+			options.ismcts.milliseconds = std::stod(argv[++i]);
+		}
+		else if (arg == "--ismcts-threads" && hasValue) {
+			options.ismcts.threads = std::stoi(argv[++i]);
+		}
+		else if (arg == "--ismcts-confidence" && hasValue) {
+			options.ismcts.confidence = std::stod(argv[++i]);
+		}
+		else if (arg == "--trace" && i + 1 < argc) {
+			options.tracePath = argv[++i];
+		}
+		else if (arg == "--replay-log" && i + 1 < argc) {
+			options.replayLogPath = argv[++i];
+		}
+		else if (arg == "--log" && i + 1 < argc) {
+			options.logPath = argv[++i];
+		}
+		else if (arg == "--trace-buffer" && hasValue) {
+			options.traceEventsPerThread = std::max(1ll, std::stoll(argv[++i]));
+		}
+		else {
+			std::cout << "Unknown or incomplete option: " << arg << "\n";
+			return false;
+		}
+	}
+
+	if (options.numberOfPlayers < MIN_PLAYERS || options.numberOfPlayers > MAX_PLAYERS) {
+		std::cout << "--players must be from " << MIN_PLAYERS << " to " << MAX_PLAYERS << ".\n";
+		return false;
+	}
+
+	return true;
+}
+
+#pragma endregion
+
+int main(int argc, char* argv[]) {
+	SimulationOptions options;
+	if (!ParseOptions(argc, argv, options))
+		return 1;
+
+	if (!options.tracePath.empty())
+		Tracer::Get().Start(options.traceEventsPerThread);
+
+	int exitCode = 0;
+	if (options.benchmark == "shuffle") {
+		RunShuffleBenchmark();
+	}
+	else if (options.benchmark == "index") {
+		RunIndexBenchmark();
+	}
+	else if (options.benchmark == "iterators") {
+		RunIteratorBenchmark();
+	}
+	else if (options.benchmark == "sort") {
+		RunSortBenchmark();
+	}
+	else if (options.benchmark == "snapshot") {
+		RunSnapshotBenchmark();
+	}
+	else if (options.benchmark == "ismcts") {
+		RunISMCTSBenchmark();
+	}
+	else if (options.benchmark == "inference") {
+		RunInferenceBenchmark();
+	}
+	else if (!options.replayLogPath.empty()) {
+		exitCode = RunReplay(options) ? 0 : 1;
+	}
+	else if (options.tournament) {
+		RunTournament(options);
+	}
+	else if (options.simulate) {
+		RunSimulation(options);
+	}
+	else {
+		GoFish();
+	}
+
+	if (!options.tracePath.empty() && !Tracer::Get().WriteJson(options.tracePath)) {
+		std::cout << "Couldn't write the trace to " << options.tracePath << "\n";
+		return 1;
+	}
 
-	return 0;
+	return exitCode;
 };
\ No newline at end of file
@@ -1,8 +1,10 @@
 #pragma once
 
 #include<string>
+#include <iostream>
 #include "Card.h"
 #include "ConstantsAndGlobals.h"
+#include "Instrumentation.h"
 
 enum GuessResultID {
 	None,
@@ -12,8 +14,6 @@ enum GuessResultID {
 	GoFish4OfAKind
 };
 
-class Player;
-
 struct Guess {
 	Guess() : targetPlayerNumber(-1), currentPlayerNumber(-1), card(Card(DECK_SIZE)), guessResult(GuessResultID::None), numberOfCardsRecieved(-1) {}
 	Guess(int TargetPlayerNumber, int CurrentPlayerNumber, int CardID, int GuessResult = GuessResultID::None, int NumberOfCardsRecieved = 1) :
@@ -32,6 +32,7 @@ struct Guess {
 	}
 
 	void PrintGuess(std::string(*GetPlayerNameFunc)(int)) {
+		INSTRUMENT_PHASE(Output);
 		std::cout << GuessToString(GetPlayerNameFunc) << std::endl;
 	}
 
@@ -82,6 +83,7 @@ struct Guess {
 	}
 
 	void PrintResult(std::string(*GetPlayerNameFunc)(int)) {
+		INSTRUMENT_PHASE(Output);
 		std::cout << ResultToString(GetPlayerNameFunc) << std::endl << std::endl;
 	}
 };
\ No newline at end of file
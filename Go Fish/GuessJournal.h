@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "GameSnapshot.h"
+
+/// <summary>
+/// Everything one resolved guess changed, so it can be undone.
+/// </summary>
+struct GuessDelta {
+	uint64_t movedCards;//Cards the target player gave to the guessing player.
+	int8_t targetPlayerNumber;
+	int8_t guessingPlayerNumber;
+	int8_t previousCurrentPlayer;
+	int8_t drawnCard;//CardID the guessing player drew when told to go fish, or -1 if they didn't draw.
+	int8_t fourOfAKindNumber;//Card number the guessing player turned in as a four of a kind, or -1.
+	PackedGuess previousLastGuess;//The guessing player's entry in lastGuesses before this guess replaced it.
+};
+
+/// <summary>
+/// Stack of GuessDeltas made by BasicGameState::MakeGuess and undone in reverse order by UnmakeGuess.
+/// Storage is reserved up front, so making and unmaking guesses never allocates unless the line goes deeper than the capacity.
+/// </summary>
+class GuessJournal {
+	std::vector<GuessDelta> deltas;
+
+public:
+	explicit GuessJournal(int Capacity = 256) {
+		deltas.reserve(Capacity);
+	}
+
+	/// <summary>
+	/// Number of guesses that can be undone.
+	/// </summary>
+	int Depth() const {
+		return static_cast<int>(deltas.size());
+	}
+
+	bool Empty() const {
+		return deltas.empty();
+	}
+
+	void Push(const GuessDelta& delta) {
+		deltas.push_back(delta);
+	}
+
+	GuessDelta Pop() {
+		GuessDelta delta = deltas.back();
+		deltas.pop_back();
+
+		return delta;
+	}
+
+	/// <summary>
+	/// Forgets every delta without undoing them, like after committing to a line.
+	/// </summary>
+	void Clear() {
+		deltas.clear();
+	}
+};
\ No newline at end of file
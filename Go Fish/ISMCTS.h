@@ -0,0 +1,459 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <cmath>
+#include <bit>
+#include <limits>
+#include <algorithm>
+#include "ConstantsAndGlobals.h"
+#include "Guess.h"
+#include "Random.h"
+#include "Shuffle.h"
+#include "LegalMoves.h"
+#include "NPC.h"
+#include "GameSnapshot.h"
+#include "GameState.h"
+#include "ThreadPool.h"
+
+/// <summary>
+/// How much ISMCTSAI searches for each move.  The search stops at whichever of iterations and milliseconds is reached first.
+/// </summary>
+struct ISMCTSSettings {
+	int iterations = 2000;//Playouts per move, split between the threads.  0 for no limit, which needs milliseconds to be set.
+	double milliseconds = 0;//Time limit per move.  0 for no limit.
+	int threads = 1;//Number of threads searching.  1 searches on the calling thread without a pool.
+	double exploration = 0.7;//UCB exploration constant.  Rewards go from 0 to 1.
+	double confidence = 0;//If above 0, MemoryAI's choice is played unless the best win rate beats it by this many standard errors.
+	int maxNodes = 1 << 16;//Tree nodes per thread.  Once a tree is full, new moves are played out without being added to it.
+};
+
+/// <summary>
+/// ISMCTSAI picks moves with Information Set Monte Carlo Tree Search (single observer).
+/// Each iteration deals the cards it can't see in a way that agrees with everything MemoryAI has learned from the guesses,
+///		restores that deal into a BitboardGameState, walks the tree with UCB using only moves that are legal in that deal,
+///		adds one node and plays out the rest of the game with ResolveGuess, everyone asking like MemoryAI.
+/// Each thread grows its own tree from its own deals, so threads never share anything while searching.  The root moves'
+///		statistics are added together once every thread is done, and the move with the best win rate is played.
+///		Setting confidence makes MemoryAI's move the default, which the search only overrides when it is clearly better.
+/// Trees, games and deals are all made once and reused, so a move doesn't allocate once the trees have grown to their largest.
+/// </summary>
+class ISMCTSAI : public MemoryAI {
+	/// <summary>
+	/// A move in a search tree.  Children are a linked list through firstChild and nextSibling, indexes into the tree.
+	/// </summary>
+	struct Node {
+		int firstChild;
+		int nextSibling;
+		int visits;
+		int availability;//Number of times the move was legal when its parent was reached.
+		double reward;//Total reward for player, the player making the move.
+		int8_t player;
+		int8_t target;
+		int8_t cardNumber;
+	};
+
+	/// <summary>
+	/// Everything one thread needs to search.  Only the thread searching with it touches it until the search is done.
+	/// </summary>
+	class Worker {
+		std::unique_ptr<BitboardGameState> game;
+		std::vector<Node> tree;
+		std::vector<int> path;//The nodes the current iteration went through, not including the root.
+		GameSnapshot deal;
+		uint8_t unseen[DECK_SIZE];
+		uint16_t knownHeld[MAX_PLAYERS];//Bit cardNumber is set when everyone at the table knows the player has that card number.
+
+	public:
+		Random random;
+		long long iterations = 0;//Iterations finished in the last search.
+
+		explicit Worker(int MaxNodes) {
+			tree.reserve(std::max(MaxNodes, 1));
+			path.reserve(DECK_SIZE * MAX_PLAYERS);
+			deal = GameSnapshot();
+		}
+
+		const std::vector<Node>& Tree() const {
+			return tree;
+		}
+
+		/// <summary>
+		/// Runs iterations until budget iterations are done (0 for no limit) or deadline passes, if hasDeadline.
+		/// </summary>
+		void Search(const ISMCTSAI& ai, long long budget, bool hasDeadline, std::chrono::steady_clock::time_point deadline) {
+			if (game == nullptr || game->players.Count() != ai.table.playerCount) {
+				game = std::make_unique<BitboardGameState>();
+				game->PopulatePlayers(ai.table.playerCount, "Determinized");
+			}
+
+			tree.clear();
+			tree.push_back({ -1, -1, 0, 0, 0.0, NO_PLAYER, NO_PLAYER, -1 });
+			for (iterations = 0; budget == 0 || iterations < budget; iterations++) {
+				//Reading the clock costs about as much as a few turns, so only check it every 16 iterations.
+				if (hasDeadline && (iterations & 15) == 0 && std::chrono::steady_clock::now() >= deadline)
+					break;
+
+				RunIteration(ai);
+			}
+		}
+
+	private:
+
+		/// <summary>
+		/// Deals every card ai can't see into deal.  Card numbers each player is known to hold are dealt to them first, then the
+		///		rest are shuffled and dealt in order, skipping cards whose number the player is known not to have.
+		/// If only skipped cards are left, the player gets them anyway rather than searching for a deal that fits exactly.
+		/// </summary>
+		void Determinize(const ISMCTSAI& ai) {
+			const TableView& table = ai.table;
+			uint64_t unknown = ai.unseenCards;
+			int needed[MAX_PLAYERS];
+			for (int player = 0; player < MAX_PLAYERS; player++) {
+				deal.hands[player] = 0;
+				needed[player] = player == table.playerNumber ? 0 : table.handSizes[player];
+			}
+
+			deal.hands[table.playerNumber] = table.hand;
+			for (int player = 0; player < table.playerCount; player++) {
+				if (needed[player] == 0)
+					continue;
+
+				for (int cardNumber = 0; cardNumber < CARDS_PER_SUIT; cardNumber++) {
+					uint32_t suits = static_cast<uint32_t>(unknown >> (cardNumber * SUITS_PER_DECK)) & 0xF;
+					int take = std::min({ static_cast<int>(ai.minimumHeld[player][cardNumber]), std::popcount(suits), needed[player] });
+					for (int i = 0; i < take; i++) {
+						int suit = LegalMoves::NthSetBit(suits, random.NextInt(std::popcount(suits)));
+						suits &= ~(1u << suit);
+						uint64_t card = 1ull << (cardNumber * SUITS_PER_DECK + suit);
+						deal.hands[player] |= card;
+						unknown &= ~card;
+					}
+
+					needed[player] -= take;
+				}
+			}
+
+			int count = 0;
+			for (; unknown != 0; unknown &= unknown - 1) {
+				unseen[count++] = static_cast<uint8_t>(std::countr_zero(unknown));
+			}
+
+			FisherYatesShuffle(unseen, count, random);
+			int next = 0;
+			for (int player = 0; player < table.playerCount; player++) {
+				for (int i = next; i < count && needed[player] > 0; i++) {
+					if (ai.knownNone[player] >> (unseen[i] / SUITS_PER_DECK) & 1)
+						continue;
+
+					std::swap(unseen[i], unseen[next]);
+					deal.hands[player] |= 1ull << unseen[next++];
+					needed[player]--;
+				}
+
+				for (; needed[player] > 0 && next < count; needed[player]--) {
+					deal.hands[player] |= 1ull << unseen[next++];
+				}
+			}
+
+			//Whatever is left is the deck.  Cards before drawIndex have already been drawn, so they are never read.
+			deal.drawIndex = static_cast<uint8_t>(DECK_SIZE - (count - next));
+			std::memcpy(deal.deck + deal.drawIndex, unseen + next, count - next);
+			for (int i = 0; i < CARDS_PER_SUIT; i++) {
+				deal.fourOfAKinds[i] = static_cast<int8_t>(ai.fourOfAKinds[i]);
+			}
+
+			deal.currentPlayer = table.playerNumber;
+			deal.playerCount = table.playerCount;
+			deal.random = random;
+		}
+
+		/// <summary>
+		/// Picks the move to play from node in the tree.  Adds an untried legal move if there is one and the tree has room,
+		///		otherwise picks the legal child with the highest UCB score.
+		/// </summary>
+		/// <returns>The node of the move, or -1 if the move couldn't be added to the full tree.</returns>
+		int SelectOrExpand(int node, const LegalMoves& moves, double exploration, Guess& guess) {
+			uint16_t tried[MAX_PLAYERS] = {};
+			int triedCount = 0;
+			int best = -1;
+			double bestScore = -std::numeric_limits<double>::infinity();
+			for (int child = tree[node].firstChild; child != -1; child = tree[child].nextSibling) {
+				Node& move = tree[child];
+				if (move.player != moves.playerNumber || !moves.Contains(move.target, move.cardNumber))
+					continue;
+
+				move.availability++;
+				tried[move.target] |= 1 << move.cardNumber;
+				triedCount++;
+				double score = move.reward / move.visits + exploration * std::sqrt(std::log(move.availability) / move.visits);
+				if (score > bestScore) {
+					bestScore = score;
+					best = child;
+				}
+			}
+
+			int untried = moves.Count() - triedCount;
+			if (untried > 0 && tree.size() < tree.capacity()) {
+				int n = random.NextInt(untried);
+				for (uint32_t targets = moves.targets; targets != 0; targets &= targets - 1) {
+					int target = std::countr_zero(targets);
+					uint32_t numbers = moves.numbers & ~tried[target];
+					int numberCount = std::popcount(numbers);
+					if (n >= numberCount) {
+						n -= numberCount;
+						continue;
+					}
+
+					int cardNumber = LegalMoves::NthSetBit(numbers, n);
+					tree.push_back({ -1, tree[node].firstChild, 0, 1, 0.0, static_cast<int8_t>(moves.playerNumber), static_cast<int8_t>(target), static_cast<int8_t>(cardNumber) });
+					tree[node].firstChild = static_cast<int>(tree.size()) - 1;
+					guess = Guess(target, moves.playerNumber, cardNumber);
+
+					return tree[node].firstChild;
+				}
+			}
+
+			if (best == -1) {
+				guess = moves.Sample(random);
+				return -1;
+			}
+
+			guess = Guess(tree[best].target, moves.playerNumber, tree[best].cardNumber);
+
+			return best;
+		}
+
+		/// <summary>
+		/// Picks a playout move the way MemoryAI would: ask someone everyone knows has one of your card numbers, otherwise anyone at random.
+		/// Random playouts assume nobody remembers anything, so they can't tell that asking gives your cards away.
+		/// </summary>
+		Guess PlayoutGuess(const LegalMoves& moves) {
+			uint16_t known[MAX_PLAYERS];
+			int knownCount = 0;
+			for (int target = 0; target < MAX_PLAYERS; target++) {
+				known[target] = (moves.targets >> target & 1) ? knownHeld[target] & moves.numbers : 0;
+				knownCount += std::popcount(known[target]);
+			}
+
+			if (knownCount == 0)
+				return moves.Sample(random);
+
+			int n = random.NextInt(knownCount);
+			for (int target = 0;; target++) {
+				int count = std::popcount(known[target]);
+				if (n < count)
+					return Guess(target, moves.playerNumber, LegalMoves::NthSetBit(known[target], n));
+
+				n -= count;
+			}
+		}
+
+		/// <summary>
+		/// Updates knownHeld with what the table learned from a resolved guess.
+		/// </summary>
+		void ObservePlayoutGuess(const Guess& guess) {
+			uint16_t bit = static_cast<uint16_t>(1 << guess.card.CardNumber());
+			knownHeld[guess.targetPlayerNumber] &= ~bit;
+			if (guess.guessResult == GuessResultID::Success4OfAKind || guess.guessResult == GuessResultID::GoFish4OfAKind) {
+				for (uint16_t& held : knownHeld) {
+					held &= ~bit;
+				}
+			}
+			else {
+				knownHeld[guess.currentPlayerNumber] |= bit;
+			}
+		}
+
+		/// <summary>
+		/// One deal, one walk down the tree, one node added, one playout and the result added to every node walked through.
+		/// </summary>
+		void RunIteration(const ISMCTSAI& ai) {
+			Determinize(ai);
+			game->Restore(deal);
+			for (int player = 0; player < MAX_PLAYERS; player++) {
+				knownHeld[player] = 0;
+				for (int cardNumber = 0; cardNumber < CARDS_PER_SUIT; cardNumber++) {
+					if (ai.minimumHeld[player][cardNumber] > 0)
+						knownHeld[player] |= 1 << cardNumber;
+				}
+			}
+
+			path.clear();
+			int node = 0;
+			bool inTree = true;
+			while (!game->GameOver()) {
+				LegalMoves moves = game->GetLegalMoves();
+				Guess guess;
+				if (moves.Empty()) {
+					guess = EmptyHandGuess(moves, game->FourOfAKinds, random);
+				}
+				else if (inTree) {
+					//A new node ends the walk down the tree.  The rest of the game is the playout.
+					int size = static_cast<int>(tree.size());
+					node = SelectOrExpand(node, moves, ai.settings.exploration, guess);
+					inTree = node != -1 && node < size;
+					if (node != -1)
+						path.push_back(node);
+				}
+				else {
+					guess = PlayoutGuess(moves);
+				}
+
+				game->ResolveGuess(guess);
+				ObservePlayoutGuess(guess);
+			}
+
+			//Split a win evenly between everyone tied for the most four of a kinds.
+			int books[MAX_PLAYERS] = {};
+			for (int cardNumber = 0; cardNumber < CARDS_PER_SUIT; cardNumber++) {
+				if (game->FourOfAKinds[cardNumber] != NO_PLAYER)
+					books[game->FourOfAKinds[cardNumber]]++;
+			}
+
+			int mostBooks = *std::max_element(books, books + ai.table.playerCount);
+			int winners = static_cast<int>(std::count(books, books + ai.table.playerCount, mostBooks));
+			tree[0].visits++;
+			for (int pathNode : path) {
+				Node& move = tree[pathNode];
+				move.visits++;
+				if (books[move.player] == mostBooks)
+					move.reward += 1.0 / winners;
+			}
+		}
+	};
+
+	std::vector<std::unique_ptr<Worker>> workers;
+	std::unique_ptr<ThreadPool> pool;//Declared after workers so the threads are joined before the workers are destroyed.
+	uint64_t unseenCards = 0;//Cards that aren't in this player's hand and haven't been turned in.
+
+public:
+	ISMCTSAI(const int(&FourOfAKinds)[CARDS_PER_SUIT], Random& RandomGenerator, const ISMCTSSettings& Settings = ISMCTSSettings()) :
+		MemoryAI(FourOfAKinds, RandomGenerator), settings(Settings) {
+		settings.threads = std::max(settings.threads, 1);
+		if (settings.iterations <= 0 && settings.milliseconds <= 0)
+			settings.iterations = ISMCTSSettings().iterations;
+
+		for (int i = 0; i < settings.threads; i++) {
+			workers.push_back(std::make_unique<Worker>(settings.maxNodes));
+		}
+
+		if (settings.threads > 1)
+			pool = std::make_unique<ThreadPool>(settings.threads);
+	}
+
+	ISMCTSSettings settings;
+	TableView table = {};
+	long long lastIterations = 0;//Iterations run by every thread for the last searched move.
+
+	bool WatchesTable() const override {
+		return true;
+	}
+
+	void ObserveTable(const TableView& Table) override {
+		MemoryAI::ObserveTable(Table);
+		table = Table;
+	}
+
+	/// <summary>
+	/// Searches until the budget in settings runs out and returns the root move with the best win rate.
+	/// Moves with less than a quarter of the most visited move's visits aren't picked, so a move that got lucky in a few
+	///		playouts doesn't beat one that has been tried many times.
+	/// If settings.confidence is above 0, the move MemoryAI scores highest (the best win rate of those breaks ties) is returned
+	///		instead unless the best win rate beats it by settings.confidence standard errors.
+	/// </summary>
+	Guess NextGuess(const LegalMoves& moves) override {
+		lastIterations = 0;
+		if (moves.Empty())
+			return EmptyHandGuess(moves, fourOfAKinds, random);
+
+		if (moves.Count() == 1)
+			return moves.At(0);
+
+		unseenCards = ((1ull << DECK_SIZE) - 1) & ~table.hand;
+		for (int cardNumber = 0; cardNumber < CARDS_PER_SUIT; cardNumber++) {
+			if (fourOfAKinds[cardNumber] != NO_PLAYER)
+				unseenCards &= ~(0xFull << (cardNumber * SUITS_PER_DECK));
+		}
+
+		//One number from the game's generator seeds every thread, so an iteration budget always searches the same way.
+		uint64_t seed = random.Next();
+		bool hasDeadline = settings.milliseconds > 0;
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double, std::milli>(settings.milliseconds));
+		int threads = static_cast<int>(workers.size());
+		for (int i = 0; i < threads; i++) {
+			workers[i]->random.Seed(Random::StreamSeed(seed, i));
+			long long budget = settings.iterations <= 0 ? 0 : settings.iterations / threads + (i < settings.iterations % threads ? 1 : 0);
+			if (pool == nullptr) {
+				workers[i]->Search(*this, budget, hasDeadline, deadline);
+			}
+			else {
+				pool->Enqueue([this, i, budget, hasDeadline, deadline] { workers[i]->Search(*this, budget, hasDeadline, deadline); });
+			}
+		}
+
+		if (pool != nullptr)
+			pool->Wait();
+
+		int visits[MAX_PLAYERS][CARDS_PER_SUIT] = {};
+		double rewards[MAX_PLAYERS][CARDS_PER_SUIT] = {};
+		int mostVisits = 0;
+		for (const std::unique_ptr<Worker>& worker : workers) {
+			lastIterations += worker->iterations;
+			const std::vector<Node>& tree = worker->Tree();
+			for (int child = tree[0].firstChild; child != -1; child = tree[child].nextSibling) {
+				visits[tree[child].target][tree[child].cardNumber] += tree[child].visits;
+				rewards[tree[child].target][tree[child].cardNumber] += tree[child].reward;
+				mostVisits = std::max(mostVisits, visits[tree[child].target][tree[child].cardNumber]);
+			}
+		}
+
+		if (mostVisits == 0)
+			return moves.Sample(random);
+
+		//The search's pick is the move with the best win rate.  MemoryAI's pick, only used with a confidence, is the move it scores
+		//	highest, with the best win rate of those to break ties.
+		Guess heuristic;
+		Guess best;
+		double heuristicWinRate = -1;
+		double bestWinRate = -1;
+		int heuristicScore = -1;
+		int heuristicVisits = 0;
+		int bestVisits = 0;
+		for (uint32_t targets = moves.targets; targets != 0; targets &= targets - 1) {
+			int target = std::countr_zero(targets);
+			for (uint32_t numbers = moves.numbers; numbers != 0; numbers &= numbers - 1) {
+				int cardNumber = std::countr_zero(numbers);
+				int moveVisits = visits[target][cardNumber];
+				if (moveVisits == 0)
+					continue;
+
+				double winRate = rewards[target][cardNumber] / moveVisits;
+				int score = Score(target, cardNumber);
+				if (score > heuristicScore || (score == heuristicScore && winRate > heuristicWinRate)) {
+					heuristicScore = score;
+					heuristicWinRate = winRate;
+					heuristicVisits = moveVisits;
+					heuristic = Guess(target, moves.playerNumber, cardNumber);
+				}
+
+				if (moveVisits * 4 >= mostVisits && winRate > bestWinRate) {
+					bestWinRate = winRate;
+					bestVisits = moveVisits;
+					best = Guess(target, moves.playerNumber, cardNumber);
+				}
+			}
+		}
+
+		if (settings.confidence <= 0)
+			return best;
+
+		double pooled = (heuristicWinRate + bestWinRate) / 2;
+		double standardError = std::sqrt(std::max(pooled * (1 - pooled), 0.01) * (1.0 / heuristicVisits + 1.0 / bestVisits));
+
+		return bestWinRate - heuristicWinRate > settings.confidence * standardError ? best : heuristic;
+	}
+};
\ No newline at end of file
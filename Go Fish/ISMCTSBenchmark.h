@@ -0,0 +1,116 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <algorithm>
+#include "ConstantsAndGlobals.h"
+#include "GameState.h"
+#include "ISMCTS.h"
+#include "Simulation.h"
+#include "ThreadPool.h"
+
+#pragma region ISMCTS Benchmark
+
+/// <summary>
+/// Plays a game between NPCs, showing every guess to each of ais, and stops on player 0's turn once at least turns guesses
+///		have been played, so ais are all looking at the same position from the middle of a game.
+/// </summary>
+void PlayToISMCTSPosition(BitboardGameState& game, std::vector<std::unique_ptr<ISMCTSAI>>& ais, uint64_t seed, int turns) {
+	game.StartGame(seed);
+	for (std::unique_ptr<ISMCTSAI>& ai : ais) {
+		ai->NewGame();
+		ai->ObserveTable(game.GetTableView(0));
+	}
+
+	for (int turn = 0; !game.GameOver() && (turn < turns || game.currentPlayer->value.playerNumber != 0); turn++) {
+		Guess guess = game.GetNPCGuess();
+		game.PlayGuess(guess);
+		for (std::unique_ptr<ISMCTSAI>& ai : ais) {
+			ai->ObserveGuess(guess);
+		}
+	}
+}
+
+/// <summary>
+/// Times one ISMCTSAI move.  Returns the time in milliseconds.
+/// </summary>
+double TimeISMCTSMove(BitboardGameState& game, ISMCTSAI& ai) {
+	ai.ObserveTable(game.GetTableView(0));
+	LegalMoves moves = game.GetLegalMoves();
+	auto start = std::chrono::steady_clock::now();
+	ai.NextGuess(moves);
+
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// <summary>
+/// Measures ISMCTSAI's search throughput (playouts per second) for each thread count on the same positions, then how long
+///		moves with a time budget actually take, since the time budget is what keeps a move's latency fixed.
+/// </summary>
+void RunISMCTSBenchmark() {
+	const int playerCounts[] = { 2, 4 };
+	std::vector<int> threadCounts = { 1, 2, 4 };
+	if (ThreadPool::DefaultThreadCount() > 4)
+		threadCounts.push_back(ThreadPool::DefaultThreadCount());
+
+	Random random(12345);
+	const int positions = 5;
+	std::cout << "Playouts per second on " << positions << " positions (" << ThreadPool::DefaultThreadCount() << " hardware threads):\n";
+	for (int numberOfPlayers : playerCounts) {
+		BitboardGameState game;
+		game.PopulatePlayers(numberOfPlayers, HeadlessPlayerName(0));
+		std::vector<std::unique_ptr<ISMCTSAI>> ais;
+		for (int threads : threadCounts) {
+			ISMCTSSettings settings;
+			settings.iterations = 20000;
+			settings.threads = threads;
+			ais.push_back(std::make_unique<ISMCTSAI>(game.FourOfAKinds, random, settings));
+		}
+
+		std::vector<double> seconds(ais.size(), 0);
+		std::vector<long long> iterations(ais.size(), 0);
+		for (int position = 0; position < positions; position++) {
+			PlayToISMCTSPosition(game, ais, GameSeed(3, position), 10);
+			for (int i = 0; i < static_cast<int>(ais.size()); i++) {
+				seconds[i] += TimeISMCTSMove(game, *ais[i]) / 1000;
+				iterations[i] += ais[i]->lastIterations;
+			}
+		}
+
+		std::cout << numberOfPlayers << " players:";
+		for (int i = 0; i < static_cast<int>(ais.size()); i++) {
+			std::cout << " " << threadCounts[i] << (threadCounts[i] == 1 ? " thread " : " threads ") << iterations[i] / seconds[i] << (i + 1 < static_cast<int>(ais.size()) ? "," : "\n");
+		}
+	}
+
+	std::cout << "\nMove latency with a time budget (2 players, threads: " << ThreadPool::DefaultThreadCount() << "):\n";
+	const double budgets[] = { 5, 20, 100 };
+	for (double budget : budgets) {
+		BitboardGameState game;
+		game.PopulatePlayers(2, HeadlessPlayerName(0));
+		ISMCTSSettings settings;
+		settings.iterations = 0;
+		settings.milliseconds = budget;
+		settings.threads = ThreadPool::DefaultThreadCount();
+		std::vector<std::unique_ptr<ISMCTSAI>> ais;
+		ais.push_back(std::make_unique<ISMCTSAI>(game.FourOfAKinds, random, settings));
+
+		int moves = std::max(10, static_cast<int>(1000 / budget));
+		std::vector<double> times;
+		long long iterations = 0;
+		for (int move = 0; move < moves; move++) {
+			PlayToISMCTSPosition(game, ais, GameSeed(4, move), move % 20);
+			times.push_back(TimeISMCTSMove(game, *ais[0]));
+			iterations += ais[0]->lastIterations;
+		}
+
+		std::sort(times.begin(), times.end());
+		std::cout << "Budget " << budget << " ms: median " << times[times.size() / 2] << " ms, p99 " << times[(times.size() * 99) / 100]
+			<< " ms, max " << times.back() << " ms, " << iterations / moves << " playouts per move\n";
+	}
+}
+
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include "linkedList.h"
+#include "Random.h"
+
+#pragma region Index Benchmark
+
+/// <summary>
+/// Looks up every index in indexes with operator[] and returns the average time per lookup in nanoseconds.
+/// </summary>
+double TimeIndexedLookups(linkedList<int>& list, const std::vector<int>& indexes, long long& checksum) {
+	auto start = std::chrono::steady_clock::now();
+	for (int index : indexes) {
+		checksum += list[index]->value;
+	}
+
+	return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / indexes.size();
+}
+
+/// <summary>
+/// Changes the list before every lookup by moving its first element to the end, so an indexed list has to rebuild its index each time.
+/// Returns the average time per change and lookup in nanoseconds.
+/// </summary>
+double TimeLookupsAfterChanges(linkedList<int>& list, const std::vector<int>& indexes, long long& checksum) {
+	auto start = std::chrono::steady_clock::now();
+	for (int index : indexes) {
+		list.First()->MoveMeBeforeOther(list.End());
+		checksum += list[index]->value;
+	}
+
+	return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / indexes.size();
+}
+
+/// <summary>
+/// Compares random operator[] lookups on walked and indexed linkedLists from 2 to 100,000 elements, both when the list is
+///		only read and when it changes before every lookup.
+/// </summary>
+void RunIndexBenchmark() {
+	Random random(12345);
+	long long checksum = 0;
+	const int sizes[] = { 2, 6, 52, 1000, 10000, 100000 };
+
+	std::cout << "operator[] time per lookup (walked / indexed):\n";
+	for (int size : sizes) {
+		linkedList<int> list;
+		for (int i = 0; i < size; i++) {
+			list.Add(i);
+		}
+
+		//Keep the total number of elements walked roughly the same for every size.
+		int lookups = static_cast<int>(std::clamp(200000000LL / size, 1000LL, 1000000LL));
+		int changingLookups = std::max(100, lookups / 100);
+		std::vector<int> indexes(lookups);
+		for (int& index : indexes) {
+			index = random.NextInt(size);
+		}
+
+		std::vector<int> changingIndexes(indexes.begin(), indexes.begin() + changingLookups);
+
+		list.SetIndexed(false);
+		double walked = TimeIndexedLookups(list, indexes, checksum);
+		double walkedChanging = TimeLookupsAfterChanges(list, changingIndexes, checksum);
+		list.SetIndexed(true);
+		checksum += list[0]->value;//Build the index before timing so only lookups are timed.
+		double indexed = TimeIndexedLookups(list, indexes, checksum);
+		double indexedChanging = TimeLookupsAfterChanges(list, changingIndexes, checksum);
+
+		std::cout << "Size " << size << ": read only " << walked << " / " << indexed << " ns (" << walked / indexed << "x), "
+			<< "changed every lookup " << walkedChanging << " / " << indexedChanging << " ns\n";
+	}
+
+	std::cout << "(checksum " << checksum << ")\n";
+}
+
+#pragma endregion
\ No newline at end of file
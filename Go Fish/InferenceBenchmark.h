@@ -0,0 +1,117 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include "ConstantsAndGlobals.h"
+#include "GameState.h"
+#include "CardInference.h"
+#include "NPC.h"
+#include "Simulation.h"
+
+#pragma region Inference Benchmark
+
+/// <summary>
+/// Chance that a player holds at least one card of cardNumber from only what MemoryAI knows: its known cards and known
+///		nones, with every other unseen card equally likely to be in any unseen card slot.
+/// </summary>
+double MemoryHoldsEstimate(const MemoryAI& memory, const TableView& table, int player, int cardNumber, int unseenOfNumber, int unseenCount) {
+	if (memory.minimumHeld[player][cardNumber] > 0)
+		return 1;
+
+	if ((memory.knownNone[player] >> cardNumber & 1) || unseenCount == 0)
+		return 0;
+
+	double none = 1;
+	for (int i = 0; i < unseenOfNumber; i++) {
+		none *= std::max(0.0, 1.0 - static_cast<double>(table.handSizes[player]) / (unseenCount - i));
+	}
+
+	return 1 - none;
+}
+
+/// <summary>
+/// Plays games between random NPCs with a CardInference and a MemoryAI watching for every seat.  Times each CardInference
+///		update, and before every guess scores each seat's chance that each other player holds each card number still in play
+///		against the real hands (Brier score, lower is better) for CardInference and for the MemoryAI estimate.
+/// </summary>
+void RunInferenceBenchmark() {
+	const int playerCounts[] = { 2, 4, 6 };
+	const int games = 2000;
+	Random random(12345);
+	std::cout << "CardInference over " << games << " games per player count:\n";
+	for (int numberOfPlayers : playerCounts) {
+		BitboardGameState game;
+		game.PopulatePlayers(numberOfPlayers, HeadlessPlayerName(0));
+		std::vector<std::unique_ptr<CardInference>> inferences;
+		std::vector<std::unique_ptr<MemoryAI>> memories;
+		for (int i = 0; i < numberOfPlayers; i++) {
+			inferences.push_back(std::make_unique<CardInference>());
+			memories.push_back(std::make_unique<MemoryAI>(game.FourOfAKinds, random));
+		}
+
+		double updateNanoseconds = 0;
+		long long updates = 0;
+		double inferenceBrier = 0;
+		double memoryBrier = 0;
+		long long predictions = 0;
+		for (int gameNumber = 0; gameNumber < games; gameNumber++) {
+			game.StartGame(GameSeed(5, gameNumber));
+			for (int i = 0; i < numberOfPlayers; i++) {
+				inferences[i]->Start(game.GetTableView(i));
+				memories[i]->NewGame();
+			}
+
+			while (!game.GameOver()) {
+				for (int i = 0; i < numberOfPlayers; i++) {
+					TableView table = game.GetTableView(i);
+					inferences[i]->Sync(table);
+					memories[i]->ObserveTable(table);
+					int unseenCount = DECK_SIZE - std::popcount(table.hand);
+					for (int cardNumber = 0; cardNumber < CARDS_PER_SUIT; cardNumber++) {
+						if (game.FourOfAKinds[cardNumber] != NO_PLAYER)
+							unseenCount -= SUITS_PER_DECK;
+					}
+
+					for (int cardNumber = 0; cardNumber < CARDS_PER_SUIT; cardNumber++) {
+						if (game.FourOfAKinds[cardNumber] != NO_PLAYER)
+							continue;
+
+						int unseenOfNumber = SUITS_PER_DECK - std::popcount(table.hand >> (cardNumber * SUITS_PER_DECK) & 0xF);
+						for (int player = 0; player < numberOfPlayers; player++) {
+							if (player == i)
+								continue;
+
+							double truth = game.players[player]->value.hand.CountOfNumber(cardNumber) > 0 ? 1 : 0;
+							double inference = inferences[i]->ProbabilityHolds(player, cardNumber);
+							double memory = MemoryHoldsEstimate(*memories[i], table, player, cardNumber, unseenOfNumber, unseenCount);
+							inferenceBrier += (inference - truth) * (inference - truth);
+							memoryBrier += (memory - truth) * (memory - truth);
+							predictions++;
+						}
+					}
+				}
+
+				Guess guess = game.GetNPCGuess();
+				game.PlayGuess(guess);
+				auto start = std::chrono::steady_clock::now();
+				for (int i = 0; i < numberOfPlayers; i++) {
+					inferences[i]->ObserveGuess(guess);
+				}
+
+				updateNanoseconds += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+				updates += numberOfPlayers;
+				for (int i = 0; i < numberOfPlayers; i++) {
+					memories[i]->ObserveGuess(guess);
+				}
+			}
+		}
+
+		std::cout << numberOfPlayers << " players: " << updateNanoseconds / updates << " ns per update, Brier score CardInference "
+			<< inferenceBrier / predictions << ", MemoryAI estimate " << memoryBrier / predictions << " (" << predictions << " predictions)\n";
+	}
+}
+
+#pragma endregion
\ No newline at end of file
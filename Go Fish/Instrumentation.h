@@ -0,0 +1,293 @@
+#pragma once
+
+/// <summary>
+/// Hot path instrumentation.  Compiled out unless GOFISH_INSTRUMENTATION is defined, so the macros below cost nothing in
+///		normal builds.  When it is defined:
+/// INSTRUMENT_PHASE(phase) times the rest of the enclosing scope as phase.
+/// INSTRUMENT_TRAVERSAL() counts one linkedList node step.
+/// INSTRUMENT_ALLOCATION() goes with every linkedList element created or destroyed, which AllocationCounters counts.
+/// Each thread keeps its own counters and fixed bucket histograms, and merges them into the totals when it exits.  The report
+///		is printed to std::cerr when the program exits.
+/// Reading the clock costs about as much as a random NPC's whole turn, so only 1 in 2^GOFISH_INSTRUMENTATION_SAMPLE_SHIFT calls
+///		of each phase is timed.  Every call is counted, and total time is estimated from the timed ones.  Define
+///		GOFISH_INSTRUMENTATION_SAMPLE_SHIFT as 0 to time every call.
+/// </summary>
+
+#ifdef GOFISH_INSTRUMENTATION
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <chrono>
+#include <mutex>
+#include <bit>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdint>
+#include "NodePool.h"
+
+#ifndef GOFISH_INSTRUMENTATION_SAMPLE_SHIFT
+#define GOFISH_INSTRUMENTATION_SAMPLE_SHIFT 8
+#endif
+
+#pragma region Instrumentation
+
+enum class InstrumentedPhase {
+	CreateAndShuffleDeck,
+	DealOpeningHands,
+	NPCGuess,
+	PlayerGuess,
+	UpdateGuessResult,
+	Output,
+	EndGame,
+	Count
+};
+
+static const char* const INSTRUMENTED_PHASE_NAMES[] = { "CreateAndShuffleDeck", "DealOpeningHands", "GetNPCGuess", "PlayerOptions",
+	"UpdateGuessResult", "PrintGuess/PrintResult", "EndGame" };
+
+const int PHASE_COUNT = static_cast<int>(InstrumentedPhase::Count);
+const int HISTOGRAM_BUCKETS = 40;//Bucket b holds times from 2^(b-1) to 2^b - 1 ns.  Bucket 0 is 0 ns.  The last bucket holds everything longer.
+const uint64_t SAMPLE_MASK = (1ull << GOFISH_INSTRUMENTATION_SAMPLE_SHIFT) - 1;
+
+/// <summary>
+/// Calls and a latency histogram for one phase.
+/// </summary>
+struct PhaseHistogram {
+	uint64_t calls;
+	uint64_t timedCalls;
+	uint64_t totalNanoseconds;//Of the timed calls.
+	uint64_t maxNanoseconds;
+	uint64_t buckets[HISTOGRAM_BUCKETS];
+
+	void Add(uint64_t nanoseconds) {
+		timedCalls++;
+		totalNanoseconds += nanoseconds;
+		maxNanoseconds = std::max(maxNanoseconds, nanoseconds);
+		buckets[std::min<int>(std::bit_width(nanoseconds), HISTOGRAM_BUCKETS - 1)]++;
+	}
+
+	void Merge(const PhaseHistogram& other) {
+		calls += other.calls;
+		timedCalls += other.timedCalls;
+		totalNanoseconds += other.totalNanoseconds;
+		maxNanoseconds = std::max(maxNanoseconds, other.maxNanoseconds);
+		for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+			buckets[i] += other.buckets[i];
+		}
+	}
+
+	/// <summary>
+	/// Gets the upper bound of the bucket the given fraction of timed calls are at or below.
+	/// </summary>
+	uint64_t Percentile(double fraction) const {
+		uint64_t rank = static_cast<uint64_t>(fraction * timedCalls);
+		uint64_t seen = 0;
+		for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+			seen += buckets[i];
+			if (seen > rank)
+				return i == 0 ? 0 : std::min<uint64_t>(maxNanoseconds, (1ull << i) - 1);
+		}
+
+		return maxNanoseconds;
+	}
+};
+
+/// <summary>
+/// Everything one thread has measured.  Trivially constructible, so the hot paths reach it with a plain thread local access
+///		instead of going through an initialization check.
+/// </summary>
+struct InstrumentationCounters {
+	PhaseHistogram phases[PHASE_COUNT];
+	uint64_t traversals;
+	uint64_t elementNews;
+	uint64_t elementDeletes;
+	uint64_t poolChunks;
+	uint64_t poolAllocations;
+	bool registered;
+
+	void Merge(const InstrumentationCounters& other) {
+		for (int i = 0; i < PHASE_COUNT; i++) {
+			phases[i].Merge(other.phases[i]);
+		}
+
+		traversals += other.traversals;
+		elementNews += other.elementNews;
+		elementDeletes += other.elementDeletes;
+		poolChunks += other.poolChunks;
+		poolAllocations += other.poolAllocations;
+	}
+};
+
+inline thread_local InstrumentationCounters threadInstrumentation;
+
+/// <summary>
+/// Time two back to back steady_clock reads take, subtracted from every timed call so short phases aren't mostly clock.
+/// Measured once, when the first thread registers.
+/// </summary>
+inline uint64_t instrumentationClockOverhead = 0;
+
+inline uint64_t MeasureClockOverhead() {
+	uint64_t fastest = UINT64_MAX;
+	for (int i = 0; i < 1000; i++) {
+		auto start = std::chrono::steady_clock::now();
+		auto end = std::chrono::steady_clock::now();
+		fastest = std::min<uint64_t>(fastest, std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+	}
+
+	return fastest;
+}
+
+/// <summary>
+/// Totals merged from threads that have exited.  Prints the report at exit.
+/// </summary>
+class InstrumentationTotals {
+	InstrumentationTotals() : totals(), threads(0) {
+		instrumentationClockOverhead = MeasureClockOverhead();
+	}
+
+	std::mutex mutex;
+	InstrumentationCounters totals;
+	int threads;
+
+public:
+	static InstrumentationTotals& Get() {
+		static InstrumentationTotals instance;
+		[[maybe_unused]] static bool printAtExit = std::atexit(Print) == 0;//Registered after instance is constructed, so it runs before instance is destroyed.
+		return instance;
+	}
+
+	/// <summary>
+	/// Adds a thread's counters, including the allocations linkedLists counted on it, and clears them.
+	/// </summary>
+	void Merge(InstrumentationCounters& counters) {
+		const AllocationCounters& allocations = AllocationCounters::Current();
+		counters.elementNews = allocations.elementNews;
+		counters.elementDeletes = allocations.elementDeletes;
+		counters.poolChunks = allocations.poolChunks;
+		counters.poolAllocations = allocations.poolAllocations;
+		std::lock_guard<std::mutex> lock(mutex);
+		totals.Merge(counters);
+		threads++;
+		bool registered = counters.registered;
+		counters = InstrumentationCounters();
+		counters.registered = registered;
+	}
+
+	/// <summary>
+	/// Prints every phase's calls, estimated total time and latency percentiles, then the traversal and allocation counts.
+	/// Threads still running when the program exits aren't included.
+	/// </summary>
+	static void Print() {
+		InstrumentationTotals& instance = Get();
+		std::lock_guard<std::mutex> lock(instance.mutex);
+		const InstrumentationCounters& totals = instance.totals;
+		double totalSeconds = 0;
+		double phaseSeconds[PHASE_COUNT];
+		for (int i = 0; i < PHASE_COUNT; i++) {
+			const PhaseHistogram& phase = totals.phases[i];
+			phaseSeconds[i] = phase.timedCalls > 0 ? 1e-9 * phase.totalNanoseconds * phase.calls / phase.timedCalls : 0;
+			totalSeconds += phaseSeconds[i];
+		}
+
+		std::ostream& out = std::cerr;
+		out << "\nInstrumentation (" << instance.threads << " threads, 1 in " << SAMPLE_MASK + 1 << " calls timed, " << instrumentationClockOverhead
+			<< " ns of clock overhead subtracted from each, phases can nest):\n";
+		for (int i = 0; i < PHASE_COUNT; i++) {
+			const PhaseHistogram& phase = totals.phases[i];
+			if (phase.calls == 0)
+				continue;
+
+			out << std::left << std::setw(24) << INSTRUMENTED_PHASE_NAMES[i] << std::right << " calls " << phase.calls << ", ~" << phaseSeconds[i] << " s ("
+				<< (totalSeconds > 0 ? 100 * phaseSeconds[i] / totalSeconds : 0) << "%)";
+			if (phase.timedCalls > 0) {
+				out << ", mean " << phase.totalNanoseconds / phase.timedCalls << " ns, p50 <= " << phase.Percentile(0.5) << " ns, p90 <= " << phase.Percentile(0.9)
+					<< " ns, p99 <= " << phase.Percentile(0.99) << " ns, max " << phase.maxNanoseconds << " ns";
+			}
+
+			out << "\n";
+		}
+
+		out << "List node traversals: " << totals.traversals << "\n";
+		out << "List elements from the global allocator: " << totals.elementNews << " new, " << totals.elementDeletes << " deleted.  From NodePools: "
+			<< totals.poolAllocations << " in " << totals.poolChunks << " chunks\n";
+	}
+};
+
+/// <summary>
+/// Merges the thread's counters into the totals when the thread exits.  Created the first time a thread records anything.
+/// </summary>
+struct InstrumentationThreadExit {
+	~InstrumentationThreadExit() {
+		InstrumentationTotals::Get().Merge(threadInstrumentation);
+	}
+};
+
+[[gnu::noinline]] inline void RegisterInstrumentationThread() {
+	InstrumentationTotals::Get();
+	thread_local InstrumentationThreadExit threadExit;
+	threadInstrumentation.registered = true;
+}
+
+/// <summary>
+/// Registers the thread the first time it records a phase, a traversal or an allocation.  Threads that never time a phase,
+///		like search workers that only resolve guesses, would otherwise never have their counts merged.
+/// </summary>
+inline void RegisterInstrumentationThreadOnce() {
+	if (!threadInstrumentation.registered) [[unlikely]]
+		RegisterInstrumentationThread();
+}
+
+/// <summary>
+/// Counts a call to phase, and times it until the end of the scope if it is one of the sampled calls.
+/// </summary>
+class PhaseTimer {
+	PhaseHistogram* timed;
+	std::chrono::steady_clock::time_point start;
+
+	/// <summary>
+	/// The sampled path is kept out of line so the other calls only add a counter increment and a branch to the phase.
+	/// </summary>
+	[[gnu::noinline]] void Start(PhaseHistogram& histogram) {
+		RegisterInstrumentationThreadOnce();
+
+		timed = &histogram;
+		start = std::chrono::steady_clock::now();
+	}
+
+	[[gnu::noinline]] void Stop() {
+		uint64_t nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+		timed->Add(nanoseconds > instrumentationClockOverhead ? nanoseconds - instrumentationClockOverhead : 0);
+	}
+
+public:
+	explicit PhaseTimer(InstrumentedPhase phase) : timed(nullptr) {
+		PhaseHistogram& histogram = threadInstrumentation.phases[static_cast<int>(phase)];
+		if ((histogram.calls++ & SAMPLE_MASK) == 0) [[unlikely]]
+			Start(histogram);
+	}
+
+	~PhaseTimer() {
+		if (timed != nullptr) [[unlikely]]
+			Stop();
+	}
+
+	PhaseTimer(const PhaseTimer& other) = delete;
+};
+
+#pragma endregion
+
+#define INSTRUMENT_CONCAT_INNER(a, b) a##b
+#define INSTRUMENT_CONCAT(a, b) INSTRUMENT_CONCAT_INNER(a, b)
+#define INSTRUMENT_PHASE(phase) PhaseTimer INSTRUMENT_CONCAT(phaseTimer, __LINE__)(InstrumentedPhase::phase)
+//Only 1 in SAMPLE_MASK + 1 traversals checks that the thread is registered.  The first one always does.
+#define INSTRUMENT_TRAVERSAL() ((threadInstrumentation.traversals++ & SAMPLE_MASK) == 0 ? RegisterInstrumentationThreadOnce() : (void)0)
+#define INSTRUMENT_ALLOCATION() RegisterInstrumentationThreadOnce()
+
+#else
+
+#define INSTRUMENT_PHASE(phase) ((void)0)
+#define INSTRUMENT_TRAVERSAL() ((void)0)
+#define INSTRUMENT_ALLOCATION() ((void)0)
+
+#endif
\ No newline at end of file
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <numeric>
+#include <algorithm>
+#include <iterator>
+#include <ranges>
+#include <execution>
+#include "linkedList.h"
+#include "Random.h"
+
+#pragma region Iterator Benchmark
+
+static_assert(std::bidirectional_iterator<linkedList<long long>::iterator>, "linkedList::iterator must be a bidirectional iterator.");
+static_assert(std::bidirectional_iterator<linkedList<long long>::const_iterator>, "linkedList::const_iterator must be a bidirectional iterator.");
+static_assert(std::ranges::bidirectional_range<linkedList<long long>>, "linkedList must be a bidirectional range.");
+
+/// <summary>
+/// Runs work repetitions times and returns the average time per repetition in nanoseconds.
+/// </summary>
+template<typename Work>
+double TimeRepetitions(int repetitions, Work work) {
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < repetitions; i++) {
+		work();
+	}
+
+	return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / repetitions;
+}
+
+/// <summary>
+/// Sums and searches linkedLists of several sizes with hand written element loops, range-for, std algorithms, std::ranges
+///		and std::execution::par on an exported vector so each approach can be compared head to head.
+/// </summary>
+void RunIteratorBenchmark() {
+	Random random(12345);
+	long long checksum = 0;
+	const int sizes[] = { 1000, 100000, 1000000 };
+
+	std::cout << "Time per pass over the list in microseconds:\n";
+	for (int size : sizes) {
+		linkedList<long long> list;
+		for (int i = 0; i < size; i++) {
+			list.Add(random.NextInt(1000));
+		}
+
+		int repetitions = std::max(5, 20000000 / size);
+		double elementLoop = TimeRepetitions(repetitions, [&] {
+			long long sum = 0;
+			for (element<long long>* current = list.First(); !current->IsEnd(); element<long long>::Inc(current)) {
+				sum += current->value;
+			}
+
+			checksum += sum;
+		});
+
+		double rangeFor = TimeRepetitions(repetitions, [&] {
+			long long sum = 0;
+			for (long long value : list) {
+				sum += value;
+			}
+
+			checksum += sum;
+		});
+
+		double accumulate = TimeRepetitions(repetitions, [&] {
+			checksum += std::accumulate(list.begin(), list.end(), 0LL);
+		});
+
+		double rangesFindIf = TimeRepetitions(repetitions, [&] {
+			//Nothing is over 1000, so this always searches the whole list.
+			checksum += std::ranges::find_if(list, [](long long value) { return value > 1000; }) == list.end();
+		});
+
+		double exportAndReduce = TimeRepetitions(repetitions, [&] {
+			std::vector<long long> values = list.ToVector();
+			checksum += std::reduce(std::execution::par, values.begin(), values.end(), 0LL);
+		});
+
+		std::vector<long long> exported = list.ToVector();
+		double reduceOnly = TimeRepetitions(repetitions, [&] {
+			checksum += std::reduce(std::execution::par, exported.begin(), exported.end(), 0LL);
+		});
+
+		std::cout << "Size " << size << ": element loop " << elementLoop / 1000 << ", range-for " << rangeFor / 1000
+			<< ", std::accumulate " << accumulate / 1000 << ", std::ranges::find_if " << rangesFindIf / 1000
+			<< ", ToVector + par reduce " << exportAndReduce / 1000 << ", par reduce on exported vector " << reduceOnly / 1000 << "\n";
+	}
+
+	std::cout << "(checksum " << checksum << ")\n";
+}
+
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <bit>
+#include <array>
+#include "ConstantsAndGlobals.h"
+#include "Guess.h"
+#include "Random.h"
+
+constexpr std::array<std::array<uint8_t, 8>, 256> MakeNthSetBitInByte() {
+	std::array<std::array<uint8_t, 8>, 256> table = {};
+	for (int byte = 0; byte < 256; byte++) {
+		int n = 0;
+		for (int bit = 0; bit < 8; bit++) {
+			if (byte >> bit & 1)
+				table[byte][n++] = static_cast<uint8_t>(bit);
+		}
+	}
+
+	return table;
+}
+
+/// <summary>
+/// NthSetBitInByte[byte][n] is the position of the nth (from 0) set bit in byte.
+/// </summary>
+inline constexpr std::array<std::array<uint8_t, 8>, 256> NthSetBitInByte = MakeNthSetBitInByte();
+
+/// <summary>
+/// LegalMoves is every guess a player is allowed to make: any other player (targets) for any card number they hold (numbers).
+/// Both are bitmasks, so the whole set is 4 bytes and the number of moves is a multiply of two popcounts.
+/// Moves are numbered from 0 to Count() - 1 so they can be listed, and Sample picks one uniformly without retrying.
+/// </summary>
+struct LegalMoves {
+	int playerNumber;//The player making the guess.
+	uint8_t targets;//Bit playerNumber is set for each player that can be asked.
+	uint16_t numbers;//Bit cardNumber is set for each card number that can be asked for.
+
+	int TargetCount() const {
+		return std::popcount(targets);
+	}
+
+	int NumberCount() const {
+		return std::popcount(numbers);
+	}
+
+	int Count() const {
+		return TargetCount() * NumberCount();
+	}
+
+	/// <summary>
+	/// True when the player has no cards, so there is nothing they are allowed to ask for.
+	/// </summary>
+	bool Empty() const {
+		return numbers == 0 || targets == 0;
+	}
+
+	bool Contains(int targetPlayerNumber, int cardNumber) const {
+		return (targets >> targetPlayerNumber & 1) && (numbers >> cardNumber & 1);
+	}
+
+	/// <summary>
+	/// Gets move number index.  Moves are ordered by target, then by card number.
+	/// </summary>
+	Guess At(int index) const {
+		int numberCount = NumberCount();
+		return Guess(NthSetBit(targets, index / numberCount), playerNumber, NthSetBit(numbers, index % numberCount));
+	}
+
+	/// <summary>
+	/// Picks a move uniformly.  Every target has the same card numbers, so picking the target and card number separately is uniform
+	///		over all moves.  Must not be Empty.
+	/// </summary>
+	Guess Sample(Random& random) const {
+		int targetPlayerNumber = NthSetBit(targets, random.NextInt(TargetCount()));
+		int cardNumber = NthSetBit(numbers, random.NextInt(NumberCount()));
+
+		return Guess(targetPlayerNumber, playerNumber, cardNumber);
+	}
+
+	/// <summary>
+	/// Gets the position of the nth (from 0) set bit in a mask of up to 16 bits.
+	/// Picks the byte with a popcount, then looks the bit up in a table, so there are no loops to mispredict.
+	/// </summary>
+	static int NthSetBit(uint32_t mask, int n) {
+		uint32_t lowByte = mask & 0xFF;
+		int lowCount = std::popcount(lowByte);
+		bool inHighByte = n >= lowCount;
+		uint32_t byte = inHighByte ? (mask >> 8) & 0xFF : lowByte;
+
+		return NthSetBitInByte[byte][inHighByte ? n - lowCount : n] + (inHighByte ? 8 : 0);
+	}
+};
\ No newline at end of file
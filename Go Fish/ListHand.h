@@ -0,0 +1,313 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <bit>
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include "ConstantsAndGlobals.h"
+#include "linkedList.h"
+#include "Card.h"
+
+/// <summary>
+/// ListHand is a sorted linkedList of cards with the card number operations needed to play Go Fish.
+/// It has the same hand interface as BitboardHand so the two can be swapped in BasicGameState and benchmarked.
+/// linkedList is a private base so its mutators, which don't know about numberCounts, can't be called on a hand.  The read only
+///		members are made public again below, and cards are only added and removed through ListHand's methods.
+/// </summary>
+class ListHand : private linkedList<Card> {
+	/// <summary>
+	/// Number of cards of each card number in the hand, and a mask with bit cardNumber set for each card number the hand has.
+	/// Kept up to date by every ListHand method that adds or removes cards, so checking and counting a card number are O(1).
+	/// </summary>
+	uint8_t numberCounts[CARDS_PER_SUIT] = {};
+	uint16_t numberMask = 0;
+
+	void CountCard(int cardID, int change) {
+		int cardNumber = cardID / SUITS_PER_DECK;
+		numberCounts[cardNumber] += change;
+		if (numberCounts[cardNumber] == 0) {
+			numberMask &= ~(1 << cardNumber);
+		}
+		else {
+			numberMask |= 1 << cardNumber;
+		}
+	}
+
+	void ClearCounts() noexcept {
+		std::fill(std::begin(numberCounts), std::end(numberCounts), 0);
+		numberMask = 0;
+	}
+
+	void CopyCounts(const ListHand& other) noexcept {
+		std::copy(std::begin(other.numberCounts), std::end(other.numberCounts), std::begin(numberCounts));
+		numberMask = other.numberMask;
+	}
+
+public:
+	using linkedList<Card>::iterator;
+	using linkedList<Card>::const_iterator;
+	using linkedList<Card>::begin;
+	using linkedList<Card>::end;
+	using linkedList<Card>::cbegin;
+	using linkedList<Card>::cend;
+	using linkedList<Card>::First;
+	using linkedList<Card>::Last;
+	using linkedList<Card>::End;
+	using linkedList<Card>::Count;
+	using linkedList<Card>::Contains;
+	using linkedList<Card>::ToVector;
+	using linkedList<Card>::ToString;
+	using linkedList<Card>::Print;
+	using linkedList<Card>::Pool;
+	using linkedList<Card>::SetPool;
+
+	ListHand() : linkedList<Card>(Card::ToString, true) {}
+
+	/// <summary>
+	/// Copies every card into new elements from the same pool.
+	/// </summary>
+	ListHand(const ListHand& other) : linkedList<Card>(other) {
+		CopyCounts(other);
+	}
+
+	/// <summary>
+	/// Move constructor used to move a hand along with its player.  Doesn't throw, so containers of players move them instead of copying.
+	/// </summary>
+	ListHand(ListHand&& other) noexcept : linkedList<Card>(std::move(other)) {
+		CopyCounts(other);
+		other.ClearCounts();
+	}
+
+	ListHand& operator=(const ListHand& other) {
+		linkedList<Card>::operator=(other);
+		CopyCounts(other);
+		return *this;
+	}
+
+	ListHand& operator=(ListHand&& other) noexcept {
+		//Moving a hand into itself has to leave its cards, so it has to leave their counts too.
+		if (this == &other)
+			return *this;
+
+		linkedList<Card>::operator=(std::move(other));
+		CopyCounts(other);
+		other.ClearCounts();
+		return *this;
+	}
+
+	/// <summary>
+	/// Adds the card to the hand in sorted order.
+	/// </summary>
+	void AddCard(const Card& card) {
+		Emplace(card);
+		CountCard(card.CardID, 1);
+	}
+
+	/// <summary>
+	/// Adds cardCount cards to the hand at once with a single sorted merge.
+	/// </summary>
+	void AddCards(const Card* cards, int cardCount) {
+		AddBatch(cards, cardCount);
+		for (int i = 0; i < cardCount; i++) {
+			CountCard(cards[i].CardID, 1);
+		}
+	}
+
+	void Clear() {
+		linkedList<Card>::Clear();
+		ClearCounts();
+	}
+
+	/// <summary>
+	/// Gets a mask with bit cardNumber set for each card number in the hand.  O(1).
+	/// </summary>
+	uint16_t HeldNumbers() const {
+		return numberMask;
+	}
+
+	/// <summary>
+	/// Fills numbers with each card number in the hand from lowest to highest, so NPCs can pick from the numbers they can ask for.
+	/// </summary>
+	/// <returns>The number of card numbers in the hand.</returns>
+	int HeldNumbers(int(&numbers)[CARDS_PER_SUIT]) const {
+		int count = 0;
+		for (uint32_t mask = numberMask; mask != 0; mask &= mask - 1) {
+			numbers[count++] = std::countr_zero(mask);
+		}
+
+		return count;
+	}
+
+	/// <summary>
+	/// Gets the hand as a mask with bit CardID set for each card, the same as BitboardHand.
+	/// </summary>
+	uint64_t Cards() const {
+		uint64_t cards = 0;
+		for (const Card& card : *this) {
+			cards |= 1ull << card.CardID;
+		}
+
+		return cards;
+	}
+
+	/// <summary>
+	/// Changes the hand to exactly the cards in the mask.  Only the cards that differ are removed or added,
+	///		so restoring a hand that barely changed is cheap.
+	/// </summary>
+	void SetCards(uint64_t cards) {
+		//Remove the cards that shouldn't be here, and clear the bits of the ones that should so only the missing cards are left.
+		element<Card>* current = First();
+		while (!current->IsEnd()) {
+			element<Card>* next = current->nextElement;
+			uint64_t bit = 1ull << current->value.CardID;
+			if (cards & bit) {
+				cards &= ~bit;
+			}
+			else {
+				CountCard(current->value.CardID, -1);
+				current->Remove();
+			}
+
+			current = next;
+		}
+
+		Card missing[DECK_SIZE];
+		int missingCount = 0;
+		for (; cards != 0; cards &= cards - 1) {
+			missing[missingCount++] = Card(std::countr_zero(cards));
+		}
+
+		AddCards(missing, missingCount);
+	}
+
+	/// <summary>
+	/// Gets the first element with a card number of cardNumber, or the element it would be inserted before if there are none.
+	/// </summary>
+	element<Card>* FindFirstOfNumber(int cardNumber) {
+		//lowestCardOfNumber is used because it minimizes the amount of searching through a players hand because the result will always be the first card of the number.
+		//Example: If the guessed card number is 3, then the lowest card number will be 8 because 3's are 8, 9, 10, and 11,
+		//	so the insert index will land at the index of the first 3 in the hand if any.  After that, increment to the right/up until no more 3's are found.
+		//
+		//Do you have any 3's?
+		//Other players hand { 0, 3, 7, 8, 10, 11, 12, 51 }
+		//                   { A, A, 2, 3,  3,  3,  4,  K }
+		Card lowestCardOfNumber(cardNumber, 0);//lowestCardOfNumber = 12
+		return FindInsertElement(lowestCardOfNumber, false);//8 (3 of Spades)
+	}
+
+	/// <summary>
+	/// Counts the cards in the hand with a card number of cardNumber.  O(1).
+	/// </summary>
+	int CountOfNumber(int cardNumber) const {
+		return numberCounts[cardNumber];
+	}
+
+	bool HasNumber(int cardNumber) const {
+		return (numberMask >> cardNumber) & 1;
+	}
+
+	/// <summary>
+	/// Moves every card with a card number of cardNumber from this hand to the other hand.
+	/// The elements themselves are moved, so nothing is created or deleted.  Both hands must share the same pool.
+	/// </summary>
+	/// <returns>The number of cards moved.</returns>
+	int GiveAllOfNumber(int cardNumber, ListHand& other) {
+		//"Go Fish" is answered without touching the list.
+		int count = numberCounts[cardNumber];
+		if (count == 0)
+			return 0;
+
+		element<Card>* first = FindFirstOfNumber(cardNumber);//first = 8 (3 of Spades)
+		element<Card>* last = first;
+		for (int i = 0; i < count; i++) {
+			element<Card>::Inc(last);
+		}
+
+		//"Give" the cards to the other player by moving the elements [first, last) into their hand.  last = 12 (4 of Spades)
+		int moved = other.SpliceSorted(*this, first, last);
+		numberCounts[cardNumber] = 0;
+		numberMask &= ~(1 << cardNumber);
+		other.numberCounts[cardNumber] += moved;
+		other.numberMask |= 1 << cardNumber;
+
+		return moved;
+	}
+
+	/// <summary>
+	/// Gets the cards with a card number of cardNumber as a mask with bit CardID set for each card.
+	/// </summary>
+	uint64_t CardsOfNumber(int cardNumber) {
+		uint64_t cards = 0;
+		element<Card>* card = FindFirstOfNumber(cardNumber);
+		for (int i = 0; i < numberCounts[cardNumber]; i++) {
+			cards |= 1ull << card->value.CardID;
+			element<Card>::Inc(card);
+		}
+
+		return cards;
+	}
+
+	/// <summary>
+	/// Moves the cards in the mask from this hand to the other hand without creating or deleting any elements.
+	/// Cards in the mask that aren't in this hand are ignored.
+	/// </summary>
+	/// <returns>The number of cards moved.</returns>
+	int GiveCards(uint64_t cards, ListHand& other) {
+		int moved = 0;
+		element<Card>* current = First();
+		while (cards != 0 && !current->IsEnd()) {
+			element<Card>* next = current->nextElement;
+			uint64_t bit = 1ull << current->value.CardID;
+			if (cards & bit) {
+				cards &= ~bit;
+				moved += other.SpliceSorted(*this, current, next);
+				CountCard(current->value.CardID, -1);
+				other.CountCard(current->value.CardID, 1);
+			}
+
+			current = next;
+		}
+
+		return moved;
+	}
+
+	/// <summary>
+	/// Removes the cards in the mask from the hand.  Cards in the mask that aren't in the hand are ignored.
+	/// </summary>
+	void RemoveCards(uint64_t cards) {
+		element<Card>* current = First();
+		while (cards != 0 && !current->IsEnd()) {
+			element<Card>* next = current->nextElement;
+			uint64_t bit = 1ull << current->value.CardID;
+			if (cards & bit) {
+				cards &= ~bit;
+				CountCard(current->value.CardID, -1);
+				current->Remove();
+			}
+
+			current = next;
+		}
+	}
+
+	/// <summary>
+	/// Removes every card with a card number of cardNumber from the hand.  Used when turning in a four of a kind.
+	/// </summary>
+	void RemoveAllOfNumber(int cardNumber) {
+		if (numberCounts[cardNumber] == 0)
+			return;
+
+		element<Card>* card = FindFirstOfNumber(cardNumber);
+		while (!card->IsEnd() && card->value.CardNumber() == cardNumber) {
+			element<Card>::Inc(card);
+			card->previousElement->Remove();
+		}
+
+		numberCounts[cardNumber] = 0;
+		numberMask &= ~(1 << cardNumber);
+	}
+};
+
+static_assert(std::is_nothrow_move_constructible_v<ListHand>, "ListHand must move without throwing so players holding one are moved instead of copied.");
+static_assert(std::is_nothrow_move_assignable_v<ListHand>, "ListHand must move assign without throwing.");
\ No newline at end of file
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+
+#pragma region Micro Benchmark
+
+/// <summary>
+/// Options for MicroBenchmarkSuite, set from the benchmark executable's command line.
+/// </summary>
+struct MicroBenchmarkOptions {
+	int samples = 200;//Timed samples per benchmark.
+	int warmupSamples = 20;//Untimed samples run first so caches, branch predictors and allocators settle.
+	std::string filter = "";//Only run benchmarks whose name contains this.
+	bool json = false;//Print the results as JSON instead of a table.
+	std::string outputPath = "";//If set, also write the JSON results to this file, e.g. to save a baseline.
+	std::string baselinePath = "";//If set, compare against the JSON results saved in this file.
+	double regressionPercent = 10;//A median more than this much slower than the baseline is a regression.
+};
+
+/// <summary>
+/// Timing of one benchmark.  All times are nanoseconds per operation.
+/// </summary>
+struct MicroBenchmarkResult {
+	std::string name;
+	long long operations;//Operations timed in each sample.
+	int samples;
+	double median;
+	double p99;
+	double min;
+	double mean;
+};
+
+/// <summary>
+/// MicroBenchmarkSuite runs benchmarks one at a time and keeps their results.
+/// Each sample runs setup untimed, then times work, which does operations operations.  work returns a value that is added to a
+///		checksum so the compiler can't drop it as unused.
+/// </summary>
+class MicroBenchmarkSuite {
+public:
+	MicroBenchmarkSuite(const MicroBenchmarkOptions& Options) : options(Options), checksum(0) {}
+
+	MicroBenchmarkOptions options;
+	std::vector<MicroBenchmarkResult> results;
+	long long checksum;
+
+	/// <summary>
+	/// Runs the benchmark name unless it is filtered out.
+	/// </summary>
+	template<typename Setup, typename Work>
+	void Run(const std::string& name, long long operations, Setup setup, Work work) {
+		if (name.find(options.filter) == std::string::npos)
+			return;
+
+		for (int i = 0; i < options.warmupSamples; i++) {
+			setup();
+			checksum += work();
+		}
+
+		std::vector<double> times(options.samples);
+		for (int i = 0; i < options.samples; i++) {
+			setup();
+			auto start = std::chrono::steady_clock::now();
+			checksum += work();
+			times[i] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / operations;
+		}
+
+		std::sort(times.begin(), times.end());
+		double total = 0;
+		for (double time : times) {
+			total += time;
+		}
+
+		MicroBenchmarkResult result = { name, operations, options.samples, times[times.size() / 2], times[(times.size() * 99) / 100], times[0], total / times.size() };
+		results.push_back(result);
+		if (!options.json)
+			std::cout << name << ": median " << result.median << " ns, p99 " << result.p99 << " ns, min " << result.min << " ns\n";
+	}
+
+	/// <summary>
+	/// Runs a benchmark without any setup.
+	/// </summary>
+	template<typename Work>
+	void Run(const std::string& name, long long operations, Work work) {
+		Run(name, operations, [] {}, work);
+	}
+
+	std::string ToJson() const {
+		std::ostringstream json;
+		json.precision(6);
+		json << "{\n  \"unit\": \"ns/op\",\n  \"samples\": " << options.samples << ",\n  \"benchmarks\": [\n";
+		for (int i = 0; i < static_cast<int>(results.size()); i++) {
+			const MicroBenchmarkResult& result = results[i];
+			json << "    { \"name\": \"" << result.name << "\", \"operations\": " << result.operations << ", \"median\": " << result.median
+				<< ", \"p99\": " << result.p99 << ", \"min\": " << result.min << ", \"mean\": " << result.mean << " }" << (i + 1 < static_cast<int>(results.size()) ? ",\n" : "\n");
+		}
+
+		json << "  ]\n}\n";
+
+		return json.str();
+	}
+
+	/// <summary>
+	/// Reads the medians from JSON written by ToJson.  Only understands that format: each benchmark's "name" comes before its "median".
+	/// </summary>
+	static std::map<std::string, double> ReadBaseline(const std::string& path, bool& ok) {
+		std::map<std::string, double> medians;
+		std::ifstream file(path);
+		ok = file.good();
+		if (!ok)
+			return medians;
+
+		std::stringstream contents;
+		contents << file.rdbuf();
+		std::string json = contents.str();
+		const std::string nameKey = "\"name\": \"";
+		const std::string medianKey = "\"median\": ";
+		for (size_t position = json.find(nameKey); position != std::string::npos; position = json.find(nameKey, position)) {
+			size_t nameStart = position + nameKey.size();
+			size_t nameEnd = json.find('"', nameStart);
+			size_t median = json.find(medianKey, nameEnd);
+			if (nameEnd == std::string::npos || median == std::string::npos)
+				break;
+
+			medians[json.substr(nameStart, nameEnd - nameStart)] = std::strtod(json.c_str() + median + medianKey.size(), nullptr);
+			position = median;
+		}
+
+		return medians;
+	}
+
+	/// <summary>
+	/// Prints how each median changed from the baseline and flags the ones more than options.regressionPercent slower.
+	/// </summary>
+	/// <returns>The number of regressions.</returns>
+	int CompareToBaseline(const std::map<std::string, double>& baseline) const {
+		int regressions = 0;
+		std::ostream& out = options.json ? std::cerr : std::cout;
+		out << "\nCompared to " << options.baselinePath << " (regression: median more than " << options.regressionPercent << "% slower):\n";
+		for (const MicroBenchmarkResult& result : results) {
+			auto found = baseline.find(result.name);
+			if (found == baseline.end() || found->second <= 0) {
+				out << result.name << ": new\n";
+				continue;
+			}
+
+			double change = 100 * (result.median / found->second - 1);
+			bool regression = change > options.regressionPercent;
+			regressions += regression ? 1 : 0;
+			out << result.name << ": " << found->second << " -> " << result.median << " ns (" << (change >= 0 ? "+" : "") << change << "%)"
+				<< (regression ? " REGRESSION" : "") << "\n";
+		}
+
+		out << regressions << (regressions == 1 ? " regression\n" : " regressions\n");
+
+		return regressions;
+	}
+};
+
+#pragma endregion
\ No newline at end of file
@@ -1,28 +1,214 @@
 #pragma once
 
 #include<string>
+#include <cstdint>
+#include <algorithm>
+#include <iterator>
 #include "ConstantsAndGlobals.h"
 #include "Guess.h"
+#include "Random.h"
+#include "LegalMoves.h"
 
+/// <summary>
+/// Everything a player can see at the table on their own turn besides the guesses: their own cards and how many cards
+///		everyone else is holding.
+/// </summary>
+struct TableView {
+	uint64_t hand;//The player's own cards.  Bit CardID is set for each card, the same as BitboardHand.
+	uint8_t handSizes[MAX_PLAYERS];//Number of cards each player is holding, indexed by player number.
+	uint8_t deckSize;
+	uint8_t playerCount;
+	int8_t playerNumber;
+};
+
+/// <summary>
+/// NPC is the interface every computer player strategy implements so they can be plugged into any seat of a BasicGameState.
+/// The game calls NewGame before each game, ObserveGuess after every guess any player makes, and NextGuess on the NPC's turns.
+/// NPCs that return true from WatchesTable are also given a TableView with ObserveTable right before each NextGuess.
+/// </summary>
 class NPC {
-	virtual Guess NextGuess() = 0;
+public:
+	virtual ~NPC() = default;
+
+	/// <summary>
+	/// Forgets everything from the previous game.
+	/// </summary>
+	virtual void NewGame() {}
+
+	/// <summary>
+	/// Called with every resolved guess from every player, including this NPC's own.  Everything in it is public to the table.
+	/// </summary>
+	virtual void ObserveGuess(const Guess& /*guess*/) {}
+
+	/// <summary>
+	/// Building a TableView isn't free, so only NPCs that ask for it get one.
+	/// </summary>
+	virtual bool WatchesTable() const {
+		return false;
+	}
+
+	virtual void ObserveTable(const TableView& /*table*/) {}
+
+	/// <summary>
+	/// Picks a guess.  Should be one of moves unless moves is Empty.
+	/// </summary>
+	virtual Guess NextGuess(const LegalMoves& moves) = 0;
+
+protected:
+
+	/// <summary>
+	/// With no cards there is nothing legal to ask for, so ask a random player for a card number that hasn't been turned in.
+	/// Any other player could be holding it, so the ask can succeed like any other.  If it doesn't, the player goes fish and
+	///		gets a card to play with.
+	/// </summary>
+	static Guess EmptyHandGuess(const LegalMoves& moves, const int(&fourOfAKinds)[CARDS_PER_SUIT], Random& random) {
+		uint32_t numbers = 0;
+		for (int cardNumber = 0; cardNumber < CARDS_PER_SUIT; cardNumber++) {
+			if (fourOfAKinds[cardNumber] == NO_PLAYER)
+				numbers |= 1 << cardNumber;
+		}
+
+		int randomPlayerNumber = LegalMoves::NthSetBit(moves.targets, random.NextInt(moves.TargetCount()));
+		int randomCardNumber = LegalMoves::NthSetBit(numbers, random.NextInt(std::popcount(numbers)));
+
+		return Guess(randomPlayerNumber, moves.playerNumber, randomCardNumber);
+	}
+};
+
+class RandomizerAI : public NPC {
+public:
+	RandomizerAI(const int(&FourOfAKinds)[CARDS_PER_SUIT], Random& RandomGenerator) : fourOfAKinds(FourOfAKinds), random(RandomGenerator) {}
+	const int(&fourOfAKinds)[CARDS_PER_SUIT];//The game's four of a kinds so card numbers that have been turned in aren't guessed.
+	Random& random;//The game's random number generator.
+
+	/// <summary>
+	/// Picks one of the legal moves uniformly without retrying.
+	/// </summary>
+	Guess NextGuess(const LegalMoves& moves) override {
+		if (moves.Empty())
+			return EmptyHandGuess(moves, fourOfAKinds, random);
+
+		return moves.Sample(random);
+	}
 };
 
-class RandomizerAI : NPC {
+/// <summary>
+/// MemoryAI remembers what every guess revealed in a players x card numbers matrix and asks where it knows cards are.
+/// Each observed guess updates a fixed number of entries, and picking a guess looks at each legal move once,
+///		so the cost of a move doesn't grow with the length of the game.
+/// </summary>
+class MemoryAI : public NPC {
 public:
-	RandomizerAI(int PlayerNumber, int PlayerCount) : playerNumber(PlayerNumber), playerCount(PlayerCount) {}
-	int playerNumber;
-	int playerCount;
-	Guess NextGuess() override {
-		int randomPlayerNumber = rand() % (playerCount - 1);
-		if (randomPlayerNumber >= playerNumber)
-			randomPlayerNumber++;
-
-		int randomCardNumber;
-		do {
-			randomCardNumber = rand() % CARDS_PER_SUIT;
-		} while (FourOfAKinds[randomCardNumber] != -1);
-
-		return Guess(randomPlayerNumber, playerNumber, randomCardNumber);
+	MemoryAI(const int(&FourOfAKinds)[CARDS_PER_SUIT], Random& RandomGenerator) : fourOfAKinds(FourOfAKinds), random(RandomGenerator) {
+		NewGame();
+	}
+
+	const int(&fourOfAKinds)[CARDS_PER_SUIT];//The game's four of a kinds so card numbers that have been turned in aren't guessed.
+	Random& random;//The game's random number generator.  Only used to break ties.
+	uint8_t minimumHeld[MAX_PLAYERS][CARDS_PER_SUIT];//The fewest cards of each card number each player is known to have.
+	uint16_t knownNone[MAX_PLAYERS];//Bit cardNumber is set when the player is known to have none of that card number.
+	uint8_t handSizes[MAX_PLAYERS];//Number of cards each player is holding, from the last TableView and the guesses since.
+
+	void NewGame() override {
+		std::fill(&minimumHeld[0][0], &minimumHeld[0][0] + MAX_PLAYERS * CARDS_PER_SUIT, 0);
+		std::fill(std::begin(knownNone), std::end(knownNone), 0);
+		std::fill(std::begin(handSizes), std::end(handSizes), 0);
+	}
+
+	/// <summary>
+	/// The hand sizes are needed to tell when an ask says nothing about the asker's hand.
+	/// </summary>
+	bool WatchesTable() const override {
+		return true;
+	}
+
+	void ObserveTable(const TableView& table) override {
+		std::copy(std::begin(table.handSizes), std::end(table.handSizes), std::begin(handSizes));
+	}
+
+	/// <summary>
+	/// Asking for a card number means the asker has at least one, unless their hand was empty and they could ask for anything.
+	/// The target either gave all of theirs or had none.
+	/// Going fish draws an unknown card, so nothing is known about what the asker doesn't have anymore.
+	/// A four of a kind takes the card number out of the game for everyone.
+	/// </summary>
+	void ObserveGuess(const Guess& guess) override {
+		int asker = guess.currentPlayerNumber;
+		int target = guess.targetPlayerNumber;
+		int cardNumber = guess.card.CardNumber();
+		uint16_t bit = static_cast<uint16_t>(1 << cardNumber);
+		int askerHeld = handSizes[asker] > 0 ? 1 : 0;//The fewest cards of cardNumber the asker had when asking.
+		bool received = guess.guessResult == GuessResultID::Success || guess.guessResult == GuessResultID::Success4OfAKind;
+		if (received) {
+			handSizes[target] -= guess.numberOfCardsRecieved;
+			handSizes[asker] += guess.numberOfCardsRecieved;
+		}
+		else {
+			handSizes[asker]++;
+		}
+
+		//The target has none either way.
+		minimumHeld[target][cardNumber] = 0;
+		knownNone[target] |= bit;
+
+		switch (guess.guessResult) {
+		case GuessResultID::Success:
+			minimumHeld[asker][cardNumber] = static_cast<uint8_t>(std::max<int>(minimumHeld[asker][cardNumber], askerHeld) + guess.numberOfCardsRecieved);
+			knownNone[asker] &= ~bit;
+			break;
+		case GuessResultID::FailGoFish:
+			minimumHeld[asker][cardNumber] = static_cast<uint8_t>(std::max<int>(minimumHeld[asker][cardNumber], askerHeld));
+			knownNone[asker] = 0;
+			break;
+		case GuessResultID::Success4OfAKind:
+		case GuessResultID::GoFish4OfAKind:
+			handSizes[asker] -= SUITS_PER_DECK;
+			for (int player = 0; player < MAX_PLAYERS; player++) {
+				minimumHeld[player][cardNumber] = 0;
+				knownNone[player] |= bit;
+			}
+
+			//When going fish draws the fourth card, the asker's hand only changed by that card number, so what they don't have stays known.
+			break;
+		default:
+			break;
+		}
+	}
+
+	/// <summary>
+	/// How good asking target for cardNumber looks from what has been seen.  Known cards score 2 or more, unknown 1, known none 0.
+	/// </summary>
+	int Score(int target, int cardNumber) const {
+		return minimumHeld[target][cardNumber] > 0 ? 2 + minimumHeld[target][cardNumber] : (knownNone[target] >> cardNumber & 1 ? 0 : 1);
+	}
+
+	/// <summary>
+	/// Asks for a card number a player is known to have (the most known cards first), then one nobody has ruled out,
+	///		and only asks a player known to have none if there is nothing else.  Ties are broken randomly.
+	/// </summary>
+	Guess NextGuess(const LegalMoves& moves) override {
+		if (moves.Empty())
+			return EmptyHandGuess(moves, fourOfAKinds, random);
+
+		int bestScore = -1;
+		int ties = 0;
+		Guess best;
+		for (uint32_t targets = moves.targets; targets != 0; targets &= targets - 1) {
+			int target = std::countr_zero(targets);
+			for (uint32_t numbers = moves.numbers; numbers != 0; numbers &= numbers - 1) {
+				int cardNumber = std::countr_zero(numbers);
+				int score = Score(target, cardNumber);
+				if (score > bestScore) {
+					bestScore = score;
+					ties = 1;
+					best = Guess(target, moves.playerNumber, cardNumber);
+				}
+				else if (score == bestScore && random.NextInt(++ties) == 0) {
+					best = Guess(target, moves.playerNumber, cardNumber);
+				}
+			}
+		}
+
+		return best;
 	}
 };
\ No newline at end of file
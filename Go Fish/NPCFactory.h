@@ -0,0 +1,52 @@
+#pragma once
+
+#include <string>
+#include <memory>
+#include "ConstantsAndGlobals.h"
+#include "Random.h"
+#include "NPC.h"
+#include "ISMCTS.h"
+#include "CardInference.h"
+
+/// <summary>
+/// Names of the strategies CreateNPC can make.
+/// </summary>
+static const std::string NPC_STRATEGIES[] = { "random", "memory", "ismcts", "bayes" };
+
+/// <summary>
+/// Creates the NPC named strategy for a game with the given four of a kinds and random number generator.
+/// ismctsSettings is only used by "ismcts".
+/// Returns nullptr if strategy isn't one of NPC_STRATEGIES.
+/// </summary>
+inline std::unique_ptr<NPC> CreateNPC(const std::string& strategy, const int(&FourOfAKinds)[CARDS_PER_SUIT], Random& RandomGenerator,
+	const ISMCTSSettings& ismctsSettings = ISMCTSSettings()) {
+	if (strategy == "random")
+		return std::make_unique<RandomizerAI>(FourOfAKinds, RandomGenerator);
+
+	if (strategy == "memory")
+		return std::make_unique<MemoryAI>(FourOfAKinds, RandomGenerator);
+
+	if (strategy == "ismcts")
+		return std::make_unique<ISMCTSAI>(FourOfAKinds, RandomGenerator, ismctsSettings);
+
+	if (strategy == "bayes")
+		return std::make_unique<BayesAI>(FourOfAKinds, RandomGenerator);
+
+	return nullptr;
+}
+
+/// <summary>
+/// Makes the NPC named strategy (one of NPC_STRATEGIES) play the seat playerNumber of game.
+/// Lives here instead of on BasicGameState because ISMCTSAI searches with a BitboardGameState.
+/// </summary>
+/// <returns>false if there is no strategy with that name.</returns>
+template<typename GameType>
+bool SetStrategy(GameType& game, int playerNumber, const std::string& strategy, const ISMCTSSettings& ismctsSettings = ISMCTSSettings()) {
+	std::unique_ptr<NPC> npc = CreateNPC(strategy, game.FourOfAKinds, game.random, ismctsSettings);
+	if (npc == nullptr)
+		return false;
+
+	game.SetNPC(playerNumber, std::move(npc));
+
+	return true;
+}
\ No newline at end of file
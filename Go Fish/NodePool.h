@@ -0,0 +1,122 @@
+#pragma once
+
+#include <new>
+#include <vector>
+
+/// <summary>
+/// Counts how often linkedLists on this thread go to the global allocator, so it can be checked that a loop doesn't allocate.
+/// </summary>
+struct AllocationCounters {
+	long long elementNews = 0;//Elements created with the global allocator because their list has no pool.
+	long long elementDeletes = 0;//Elements deleted with the global allocator because their list has no pool.
+	long long poolChunks = 0;//Chunks of memory NodePools got from the global allocator.
+	long long poolAllocations = 0;//Elements created from a NodePool.  These don't use the global allocator.
+
+	/// <summary>
+	/// Number of times the global allocator was asked for memory.
+	/// </summary>
+	long long GlobalAllocations() const {
+		return elementNews + poolChunks;
+	}
+
+	/// <summary>
+	/// Gets the counters for the current thread.
+	/// </summary>
+	static AllocationCounters& Current() {
+		thread_local AllocationCounters counters;
+		return counters;
+	}
+};
+
+/// <summary>
+/// NodePool hands out memory for Node objects from chunks of chunkSize nodes and keeps freed nodes on a free list to reuse.
+/// Memory only goes back to the global allocator when the pool is destroyed, so once the pool has grown to the most nodes
+///		that are alive at once, creating and removing nodes never calls the global allocator.
+/// Not thread safe.  Use one pool per game or per thread.
+/// </summary>
+template<typename Node>
+class NodePool {
+	NodePool(const NodePool& other) = delete;//Delete copy constructor to prevent copying NodePool objects.
+
+	union Slot {
+		Slot* nextFree;
+		alignas(Node) unsigned char storage[sizeof(Node)];
+	};
+
+	std::vector<Slot*> chunks;
+	Slot* freeList = nullptr;
+	int chunkSize;
+	int capacity = 0;
+	int live = 0;
+
+	void Grow() {
+		Slot* chunk = static_cast<Slot*>(::operator new(sizeof(Slot) * chunkSize));
+		chunks.push_back(chunk);
+		AllocationCounters::Current().poolChunks++;
+
+		//Chain the new slots onto the free list.
+		for (int i = chunkSize - 1; i >= 0; i--) {
+			chunk[i].nextFree = freeList;
+			freeList = &chunk[i];
+		}
+
+		capacity += chunkSize;
+	}
+
+public:
+	explicit NodePool(int ChunkSize = 64) : chunkSize(ChunkSize > 0 ? ChunkSize : 1) {}
+
+	/// <summary>
+	/// All nodes must have been destroyed before the pool is.
+	/// </summary>
+	~NodePool() {
+		for (Slot* chunk : chunks) {
+			::operator delete(chunk);
+		}
+	}
+
+	/// <summary>
+	/// Gets uninitialized memory for one Node.
+	/// </summary>
+	void* Allocate() {
+		if (freeList == nullptr)
+			Grow();
+
+		Slot* slot = freeList;
+		freeList = slot->nextFree;
+		live++;
+		AllocationCounters::Current().poolAllocations++;
+
+		return slot->storage;
+	}
+
+	/// <summary>
+	/// Returns memory from Allocate to the pool.  The Node must already be destroyed.
+	/// </summary>
+	void Free(void* node) {
+		Slot* slot = reinterpret_cast<Slot*>(node);
+		slot->nextFree = freeList;
+		freeList = slot;
+		live--;
+	}
+
+	/// <summary>
+	/// Grows the pool until it can hold at least count nodes so they can all be created without allocating.
+	/// </summary>
+	void Reserve(int count) {
+		while (capacity < count) {
+			Grow();
+		}
+	}
+
+	int Capacity() const {
+		return capacity;
+	}
+
+	/// <summary>
+	/// Number of nodes currently handed out.
+	/// </summary>
+	int Live() const {
+		return live;
+	}
+};
\ No newline at end of file
@@ -1,50 +1,59 @@
 #pragma once
 
 #include<string>
+#include <type_traits>
 #include "ConstantsAndGlobals.h"
-#include "linkedList.h"
 #include "Card.h"
-
-class Player {
-	Player(const Player& other) = delete;//Delete copy constructor to prevent copying Player objects.
+#include "ListHand.h"
+#include "BitboardHand.h"
+
+/// <summary>
+/// HandType is the hand representation, either ListHand or BitboardHand.
+/// </summary>
+template<typename HandType>
+class BasicPlayer {
+	BasicPlayer(const BasicPlayer& other) = delete;//Delete copy constructor to prevent copying Player objects.
 public:
 	int playerNumber;
-	Player() : playerNumber(-1), name("Default"), hand(Card::ToString, true) {}
-	Player(int PlayerNumber) : playerNumber(PlayerNumber), name("Player " + std::to_string(playerNumber)), hand(Card::ToString, true) {}
-	Player(int PlayerNumber, std::string FullName) : playerNumber(PlayerNumber), name(FullName), hand(Card::ToString, true) {}
+	BasicPlayer() : playerNumber(-1), name("Default") {}
+	BasicPlayer(int PlayerNumber) : playerNumber(PlayerNumber), name("Player " + std::to_string(playerNumber)) {}
+	BasicPlayer(int PlayerNumber, std::string FullName) : playerNumber(PlayerNumber), name(FullName) {}
 	std::string name;
-	linkedList<Card> hand;
+	HandType hand;
 
 	/// <summary>
 	/// Move constructor used to move a player from one container to another when using std containers.
 	/// </summary>
-	Player(Player&& other) noexcept : playerNumber(std::move(other.playerNumber)), name(std::move(other.name)), hand(std::move(other.hand)) {}
+	BasicPlayer(BasicPlayer&& other) noexcept(std::is_nothrow_move_constructible_v<HandType>) : playerNumber(std::move(other.playerNumber)), name(std::move(other.name)), hand(std::move(other.hand)) {}
 
-	bool operator==(const Player& other) const {
+	bool operator==(const BasicPlayer& other) const {
 		return playerNumber == other.playerNumber;
 	}
 
-	bool operator!=(const Player& other) const {
+	bool operator!=(const BasicPlayer& other) const {
 		return !(*this == other);
 	}
 
-	bool operator<(const Player& other) const {
+	bool operator<(const BasicPlayer& other) const {
 		return playerNumber < other.playerNumber;
 	}
 
-	bool operator>(const Player& other) const {
+	bool operator>(const BasicPlayer& other) const {
 		return playerNumber > other.playerNumber;
 	}
 
-	bool operator<=(const Player& other) const {
+	bool operator<=(const BasicPlayer& other) const {
 		return playerNumber <= other.playerNumber;
 	}
 
-	bool operator>=(const Player& other) const {
+	bool operator>=(const BasicPlayer& other) const {
 		return playerNumber >= other.playerNumber;
 	}
 
-	static std::string ToString(const Player& player) {
+	static std::string ToString(const BasicPlayer& player) {
 		return player.name;
 	}
-};
\ No newline at end of file
+};
+
+typedef BasicPlayer<ListHand> Player;
+typedef BasicPlayer<BitboardHand> BitboardPlayer;
\ No newline at end of file
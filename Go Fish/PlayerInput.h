@@ -31,7 +31,7 @@ bool is_integer(const std::string& str) {
 		return false;
 
 	bool found_minus = (str[0] == '-');
-	for (int i = (found_minus ? 1 : 0); i < str.length(); i++) {
+	for (int i = (found_minus ? 1 : 0); i < static_cast<int>(str.length()); i++) {
 		if (!isdigit(str[i]))
 			return false;
 	}
@@ -103,7 +103,7 @@ int get_integer_input_in_range(const std::string& prompt, int range_min, int ran
 int get_option(const std::vector<std::string>& option_list) {
 	// List of all options with number labels
 	std::vector<std::string> options;
-	for (int i = 0; i < option_list.size(); i++) {
+	for (int i = 0; i < static_cast<int>(option_list.size()); i++) {
 		options.push_back(std::to_string(i + 1) + ". " + option_list[i]);
 	}
 
@@ -115,7 +115,7 @@ template<size_t S>
 int get_option(const std::string(&option_list)[S]) {
 	// List of all options with number labels
 	std::vector<std::string> options;
-	for (int i = 0; i < S; i++) {
+	for (int i = 0; i < static_cast<int>(S); i++) {
 		options.push_back(std::to_string(i + 1) + ". " + option_list[i]);
 	}
 
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+/// <summary>
+/// Random is a small, fast xoshiro256** generator.  Each game owns one so games never share random state, and
+///		a game seeded with the same 64 bit seed plays out exactly the same on any thread.
+/// Satisfies UniformRandomBitGenerator so it can also be passed to std algorithms.
+/// </summary>
+class Random {
+	uint64_t state[4];
+
+	static uint64_t RotateLeft(uint64_t x, int k) {
+		return (x << k) | (x >> (64 - k));
+	}
+
+public:
+
+#pragma region Constructors/Seeding
+
+	typedef uint64_t result_type;
+
+	Random(uint64_t seed = 0) {
+		Seed(seed);
+	}
+
+	/// <summary>
+	/// Advances x and returns the next splitmix64 value.  Used to spread a seed across the whole state.
+	/// </summary>
+	static uint64_t SplitMix64(uint64_t& x) {
+		uint64_t z = (x += 0x9e3779b97f4a7c15ull);
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+		return z ^ (z >> 31);
+	}
+
+	void Seed(uint64_t seed) {
+		for (uint64_t& s : state) {
+			s = SplitMix64(seed);
+		}
+	}
+
+	/// <summary>
+	/// Gets the seed for an independent stream, such as game number stream of a simulation seeded with seed.
+	/// The same seed and stream always give the same result, no matter which thread asks for it.
+	/// </summary>
+	static uint64_t StreamSeed(uint64_t seed, uint64_t stream) {
+		uint64_t x = seed ^ (stream * 0xd1b54a32d192ed03ull);
+		return SplitMix64(x);
+	}
+
+#pragma endregion
+
+#pragma region Generating
+
+	uint64_t Next() {
+		const uint64_t result = RotateLeft(state[1] * 5, 7) * 9;
+		const uint64_t t = state[1] << 17;
+		state[2] ^= state[0];
+		state[3] ^= state[1];
+		state[1] ^= state[2];
+		state[0] ^= state[3];
+		state[2] ^= t;
+		state[3] = RotateLeft(state[3], 45);
+
+		return result;
+	}
+
+	/// <summary>
+	/// Gets an unbiased random number from 0 to bound - 1 using Lemire's multiply and shift method.
+	/// </summary>
+	int NextInt(int bound) {
+		uint32_t range = static_cast<uint32_t>(bound);
+		uint64_t product = (Next() >> 32) * range;
+		uint32_t low = static_cast<uint32_t>(product);
+		if (low < range) {
+			//Reject the few values that would make the low numbers more likely.
+			uint32_t threshold = (0u - range) % range;
+			while (low < threshold) {
+				product = (Next() >> 32) * range;
+				low = static_cast<uint32_t>(product);
+			}
+		}
+
+		return static_cast<int>(product >> 32);
+	}
+
+	/// <summary>
+	/// Equivalent to 2^128 calls to Next().  Used to split one generator into non-overlapping streams.
+	/// </summary>
+	void Jump() {
+		static const uint64_t JUMP[] = { 0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull, 0xa9582618e03fc9aaull, 0x39abdc4529b1661cull };
+		uint64_t jumped[4] = { 0, 0, 0, 0 };
+		for (uint64_t jump : JUMP) {
+			for (int b = 0; b < 64; b++) {
+				if (jump & (1ull << b)) {
+					for (int i = 0; i < 4; i++) {
+						jumped[i] ^= state[i];
+					}
+				}
+
+				Next();
+			}
+		}
+
+		for (int i = 0; i < 4; i++) {
+			state[i] = jumped[i];
+		}
+	}
+
+	/// <summary>
+	/// Returns a copy of this generator, then jumps this one ahead so the two never overlap.
+	/// </summary>
+	Random Split() {
+		Random other = *this;
+		Jump();
+		return other;
+	}
+
+	static constexpr uint64_t min() {
+		return 0;
+	}
+
+	static constexpr uint64_t max() {
+		return std::numeric_limits<uint64_t>::max();
+	}
+
+	uint64_t operator()() {
+		return Next();
+	}
+
+#pragma endregion
+};
\ No newline at end of file
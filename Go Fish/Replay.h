@@ -0,0 +1,378 @@
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <atomic>
+#include <mutex>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "ConstantsAndGlobals.h"
+#include "Card.h"
+#include "Guess.h"
+#include "GameState.h"
+#include "GameLog.h"
+#include "Simulation.h"
+#include "ThreadPool.h"
+#include "Utility.h"
+
+#pragma region Mapped File
+
+/// <summary>
+/// Read only memory map of a whole file.  The OS pages the file in as it is read, so replaying doesn't copy it through a buffer.
+/// </summary>
+class MappedFile {
+	MappedFile(const MappedFile& other) = delete;
+
+#ifdef _WIN32
+	HANDLE file = INVALID_HANDLE_VALUE;
+	HANDLE mapping = nullptr;
+#else
+	int file = -1;
+#endif
+
+public:
+	MappedFile() : data(nullptr), size(0) {}
+
+	~MappedFile() {
+		Close();
+	}
+
+	const uint8_t* data;
+	size_t size;
+
+	/// <summary>
+	/// Maps path.  An empty file opens with data null and size 0.
+	/// </summary>
+	/// <returns>False if the file couldn't be opened or mapped.</returns>
+	bool Open(const std::string& path) {
+		Close();
+#ifdef _WIN32
+		file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		LARGE_INTEGER fileSize;
+		if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &fileSize))
+			return false;
+
+		size = static_cast<size_t>(fileSize.QuadPart);
+		if (size == 0)
+			return true;
+
+		mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping == nullptr)
+			return false;
+
+		data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+		file = open(path.c_str(), O_RDONLY);
+		struct stat status;
+		if (file == -1 || fstat(file, &status) != 0)
+			return false;
+
+		size = static_cast<size_t>(status.st_size);
+		if (size == 0)
+			return true;
+
+		void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+		if (mapped == MAP_FAILED)
+			return false;
+
+		madvise(mapped, size, MADV_SEQUENTIAL);//Read once from front to back, so read ahead aggressively.
+		data = static_cast<const uint8_t*>(mapped);
+#endif
+		return data != nullptr;
+	}
+
+	void Close() {
+#ifdef _WIN32
+		if (data != nullptr)
+			UnmapViewOfFile(data);
+
+		if (mapping != nullptr)
+			CloseHandle(mapping);
+
+		if (file != INVALID_HANDLE_VALUE)
+			CloseHandle(file);
+
+		mapping = nullptr;
+		file = INVALID_HANDLE_VALUE;
+#else
+		if (data != nullptr)
+			munmap(const_cast<uint8_t*>(data), size);
+
+		if (file != -1)
+			close(file);
+
+		file = -1;
+#endif
+		data = nullptr;
+		size = 0;
+	}
+};
+
+#pragma endregion
+
+#pragma region Replay
+
+static const char* const GUESS_RESULT_NAMES[] = { "None", "FailGoFish", "Success", "Success4OfAKind", "GoFish4OfAKind" };
+
+std::string GuessResultName(int guessResult) {
+	return guessResult >= 0 && guessResult < SizeOfArray(GUESS_RESULT_NAMES) ? GUESS_RESULT_NAMES[guessResult] : "unknown result " + std::to_string(guessResult);
+}
+
+/// <summary>
+/// Where a replay first stopped matching its log.
+/// </summary>
+struct ReplayDivergence {
+	std::string shard;
+	long long gameNumber = -1;//-1 if nothing diverged.
+	int guessIndex = -1;//-1 if the game diverged outside of a guess, e.g. its header or its end.
+	std::string description;
+};
+
+/// <summary>
+/// Totals from replaying one or more shards.
+/// </summary>
+struct ReplayResults {
+	long long games = 0;
+	long long guesses = 0;
+	long long bytes = 0;
+	long long divergedGames = 0;
+	int shards = 0;
+	int unreadableShards = 0;//Shards that couldn't be opened, had a bad header or ended in the middle of a game.
+	ReplayDivergence first;//The divergence with the lowest game number.  Unreadable shards are reported here too.
+
+	void AddDivergence(const ReplayDivergence& divergence) {
+		if (first.gameNumber == -1 || divergence.gameNumber < first.gameNumber)
+			first = divergence;
+	}
+
+	void Merge(const ReplayResults& other) {
+		games += other.games;
+		guesses += other.guesses;
+		bytes += other.bytes;
+		divergedGames += other.divergedGames;
+		shards += other.shards;
+		unreadableShards += other.unreadableShards;
+		if (other.first.gameNumber != -1)
+			AddDivergence(other.first);
+	}
+};
+
+/// <summary>
+/// Describes a guess for a divergence report, e.g. "Player 0 asked Player 1 for 5's".
+/// </summary>
+std::string DescribeLoggedGuess(const LoggedGuess& logged) {
+	return HeadlessPlayerName(logged.CurrentPlayerNumber()) + " asked " + HeadlessPlayerName(logged.TargetPlayerNumber()) + " for "
+		+ Card::NumberName(logged.CardNumber()) + "'s";
+}
+
+/// <summary>
+/// Replays the game at cursor through the real rules (PlayGuess: transfers, go fish draws and four of a kind awards), checking
+///		each guess was legal and got the logged result, and that the game ended exactly after its last guess.
+/// Moves cursor past the game.
+/// </summary>
+/// <returns>False if the game diverged.  divergence says where.</returns>
+template<typename GameType>
+bool ReplayGame(GameType& game, const uint8_t*& cursor, long long& gameNumber, ReplayDivergence& divergence) {
+	gameNumber = static_cast<long long>(ReadLittleEndian(cursor, 8));
+	int firstPlayer = static_cast<int8_t>(cursor[8]);
+	int guessCount = static_cast<int>(ReadLittleEndian(cursor + 9, 2));
+	uint8_t deckOrder[DECK_SIZE];
+	UnpackDeckOrder(cursor + 11, deckOrder);
+	const uint8_t* records = cursor + GAME_LOG_GAME_HEADER_SIZE;
+	cursor = records + guessCount * sizeof(LoggedGuess);
+	divergence.gameNumber = gameNumber;
+	divergence.guessIndex = -1;
+
+	uint64_t seen = 0;
+	for (uint8_t cardID : deckOrder) {
+		seen |= 1ull << cardID;
+	}
+
+	if (seen != (1ull << DECK_SIZE) - 1 || firstPlayer < 0 || firstPlayer >= game.players.Count()) {
+		divergence.description = "the deck order or first player is invalid";
+		return false;
+	}
+
+	game.StartGameFromDeck(deckOrder, firstPlayer);
+	for (int i = 0; i < guessCount; i++) {
+		LoggedGuess logged = { static_cast<uint16_t>(records[2 * i] | records[2 * i + 1] << 8) };
+		divergence.guessIndex = i;
+		if (game.GameOver()) {
+			divergence.description = "the game was already over before " + DescribeLoggedGuess(logged);
+			return false;
+		}
+
+		int currentPlayerNumber = game.currentPlayer->value.playerNumber;
+		int target = logged.TargetPlayerNumber();
+		if (logged.CurrentPlayerNumber() != currentPlayerNumber) {
+			divergence.description = DescribeLoggedGuess(logged) + ", but it was " + HeadlessPlayerName(currentPlayerNumber) + "'s turn";
+			return false;
+		}
+
+		//With an empty hand, a player may ask for any card number that hasn't been turned in (NPC::EmptyHandGuess).
+		const auto& hand = game.currentPlayer->value.hand;
+		if (target == currentPlayerNumber || target >= game.players.Count() || logged.CardNumber() >= CARDS_PER_SUIT
+			|| (hand.CountOfNumber(logged.CardNumber()) == 0 && (hand.Count() > 0 || game.FourOfAKinds[logged.CardNumber()] != NO_PLAYER))) {
+			divergence.description = DescribeLoggedGuess(logged) + ", which isn't a legal guess";
+			return false;
+		}
+
+		Guess guess = logged.Question();
+		game.PlayGuess(guess);
+		LoggedGuess replayed = LoggedGuess::Pack(guess);
+		if (replayed.bits != logged.bits) {
+			divergence.description = DescribeLoggedGuess(logged) + ": logged " + GuessResultName(logged.GuessResult())
+				+ " (" + std::to_string(logged.NumberOfCardsRecieved()) + " cards), replayed " + GuessResultName(replayed.GuessResult())
+				+ " (" + std::to_string(replayed.NumberOfCardsRecieved()) + " cards)";
+			return false;
+		}
+	}
+
+	divergence.guessIndex = -1;
+	if (!game.GameOver()) {
+		divergence.description = "the log ended after " + std::to_string(guessCount) + " guesses, but the replayed game wasn't over";
+		return false;
+	}
+
+	return true;
+}
+
+/// <summary>
+/// Replays every game in one shard and adds them to results.  Games after a divergence are still replayed, since each game
+///		starts from its own logged deck.  A shard that ends in the middle of a game stops there.
+/// </summary>
+template<typename GameType>
+void ReplayShard(const std::string& path, ReplayResults& results) {
+	results.shards++;
+	ReplayDivergence divergence;
+	divergence.shard = path;
+	MappedFile file;
+	if (!file.Open(path) || file.size < GAME_LOG_FILE_HEADER_SIZE || std::memcmp(file.data, GAME_LOG_MAGIC, sizeof(GAME_LOG_MAGIC)) != 0
+		|| ReadLittleEndian(file.data + 8, 2) != GAME_LOG_VERSION || file.data[10] < MIN_PLAYERS || file.data[10] > MAX_PLAYERS) {
+		results.unreadableShards++;
+		divergence.gameNumber = 0;
+		divergence.description = "couldn't be opened or isn't a version " + std::to_string(GAME_LOG_VERSION) + " game log";
+		results.AddDivergence(divergence);
+		return;
+	}
+
+	GameType game;
+	game.PopulatePlayers(file.data[10], HeadlessPlayerName(0));
+	const uint8_t* cursor = file.data + GAME_LOG_FILE_HEADER_SIZE;
+	const uint8_t* end = file.data + file.size;
+	long long lastGameNumber = 0;
+	while (cursor < end) {
+		if (end - cursor < GAME_LOG_GAME_HEADER_SIZE || end - cursor < GAME_LOG_GAME_HEADER_SIZE + 2 * static_cast<long long>(ReadLittleEndian(cursor + 9, 2))) {
+			results.unreadableShards++;
+			divergence.gameNumber = end - cursor >= 8 ? static_cast<long long>(ReadLittleEndian(cursor, 8)) : lastGameNumber + 1;
+			divergence.guessIndex = -1;
+			divergence.description = "the shard ends in the middle of this game";
+			results.AddDivergence(divergence);
+			break;
+		}
+
+		const uint8_t* records = cursor + GAME_LOG_GAME_HEADER_SIZE;
+		if (!ReplayGame(game, cursor, lastGameNumber, divergence)) {
+			results.divergedGames++;
+			results.AddDivergence(divergence);
+		}
+
+		results.games++;
+		results.guesses += (cursor - records) / sizeof(LoggedGuess);
+	}
+
+	results.bytes += file.size;
+}
+
+/// <summary>
+/// Gets the shards of the log at path: path itself if it exists, otherwise path.0, path.1 and so on as written by --log.
+/// </summary>
+std::vector<std::string> FindLogShards(const std::string& path) {
+	if (std::ifstream(path).good())
+		return { path };
+
+	std::vector<std::string> shards;
+	for (int worker = 0; std::ifstream(GameLogShardPath(path, worker)).good(); worker++) {
+		shards.push_back(GameLogShardPath(path, worker));
+	}
+
+	return shards;
+}
+
+/// <summary>
+/// Replays shards on a thread pool.  Each worker takes the next shard from a shared counter, so workers that finish early keep working.
+/// </summary>
+template<typename GameType>
+ReplayResults ReplayShards(const std::vector<std::string>& shards, int threads) {
+	ReplayResults results;
+	std::atomic<size_t> nextShard(0);
+	std::mutex resultsMutex;
+
+	ThreadPool pool(std::min<int>(threads > 0 ? threads : ThreadPool::DefaultThreadCount(), static_cast<int>(shards.size())));
+	for (int i = 0; i < pool.ThreadCount(); i++) {
+		pool.Enqueue([&] {
+			ReplayResults threadResults;
+			size_t shard;
+			while ((shard = nextShard.fetch_add(1)) < shards.size()) {
+				ReplayShard<GameType>(shards[shard], threadResults);
+			}
+
+			std::lock_guard<std::mutex> lock(resultsMutex);
+			results.Merge(threadResults);
+		});
+	}
+
+	pool.Wait();
+
+	return results;
+}
+
+/// <summary>
+/// Replays the game log at options.replayLogPath and prints whether every game matched, and the first divergence if not.
+/// </summary>
+/// <returns>True if every game matched.</returns>
+bool RunReplay(const SimulationOptions& options) {
+	std::vector<std::string> shards = FindLogShards(options.replayLogPath);
+	if (shards.empty()) {
+		std::cout << "No game log found at " << options.replayLogPath << " or " << GameLogShardPath(options.replayLogPath, 0) << "\n";
+		return false;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	ReplayResults results = options.bitboardHands ? ReplayShards<BitboardGameState>(shards, options.threads) : ReplayShards<GameState>(shards, options.threads);
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::cout << "Replayed " << results.games << " games (" << results.guesses << " guesses) from " << results.shards << " shards, Hands: "
+		<< (options.bitboardHands ? "bitboard" : "list") << "\n";
+	std::cout << "Time: " << seconds << "s (" << (seconds > 0 ? results.games / seconds : 0) << " games/s, " << (seconds > 0 ? results.bytes / seconds / 1e6 : 0) << " MB/s)\n";
+	if (results.first.gameNumber == -1) {
+		std::cout << "Every game matched its log.\n";
+		return true;
+	}
+
+	std::cout << results.divergedGames << " games diverged, " << results.unreadableShards << " shards couldn't be read completely.\n";
+	const ReplayDivergence& first = results.first;
+	std::cout << "First divergence: " << first.shard << ", game " << first.gameNumber;
+	if (first.guessIndex != -1)
+		std::cout << ", guess " << first.guessIndex;
+
+	std::cout << ": " << first.description << "\n";
+
+	return false;
+}
+
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <utility>
+#include "Random.h"
+
+/// <summary>
+/// Shuffles values[0, count) in place with a Fisher-Yates shuffle.  Every order is equally likely and it takes count - 1 swaps.
+/// </summary>
+template<typename T>
+void FisherYatesShuffle(T* values, int count, Random& random) {
+	for (int i = count - 1; i > 0; i--) {
+		int j = random.NextInt(i + 1);
+		std::swap(values[i], values[j]);
+	}
+}
+
+/// <summary>
+/// Shuffles a fixed size array in place with a Fisher-Yates shuffle.
+/// </summary>
+template<typename T, size_t S>
+void FisherYatesShuffle(T(&values)[S], Random& random) {
+	FisherYatesShuffle(values, static_cast<int>(S), random);
+}
\ No newline at end of file
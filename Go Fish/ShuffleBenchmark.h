@@ -0,0 +1,172 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <stack>
+#include "ConstantsAndGlobals.h"
+#include "linkedList.h"
+#include "Card.h"
+#include "GameState.h"
+#include "Random.h"
+#include "Shuffle.h"
+#include "Deck.h"
+
+#pragma region Shuffle Benchmark
+
+/// <summary>
+/// Creates a linked list of cards that are ordered.  The deck the game used before Deck, kept to benchmark against.
+/// </summary>
+std::unique_ptr<linkedList<Card>> CreateListDeck() {
+	std::unique_ptr<linkedList<Card>> deck = std::make_unique<linkedList<Card>>(Card::ToString);
+	for (int i = 0; i < SUITS_PER_DECK; ++i) {
+		for (int j = 0; j < CARDS_PER_SUIT; ++j) {
+			deck->Emplace(j, i);
+		}
+	}
+
+	return deck;
+}
+
+/// <summary>
+/// Runs shuffle once per iteration and returns the average time per call in nanoseconds.
+/// </summary>
+double TimeShuffle(long long iterations, const std::function<void()>& shuffle) {
+	auto start = std::chrono::steady_clock::now();
+	for (long long i = 0; i < iterations; i++) {
+		shuffle();
+	}
+
+	return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+/// <summary>
+/// Result of a chi-square test on how often each value lands in each position.
+/// </summary>
+struct ChiSquareResult {
+	double chiSquare;
+	int degreesOfFreedom;
+
+	/// <summary>
+	/// Wilson-Hilferty approximation of the standard normal score of chiSquare.
+	/// Scores above 3 mean the shuffle is almost certainly biased.
+	/// </summary>
+	double ZScore() const {
+		double k = degreesOfFreedom;
+		return (std::cbrt(chiSquare / k) - (1.0 - 2.0 / (9.0 * k))) / std::sqrt(2.0 / (9.0 * k));
+	}
+
+	bool Uniform() const {
+		return ZScore() < 3.0;
+	}
+};
+
+/// <summary>
+/// Shuffles an ordered list of size values trials times and checks that every value is equally likely to end up in every position.
+/// shuffle is given the ordered values and must shuffle them in place.
+/// </summary>
+ChiSquareResult ChiSquarePositionTest(int size, long long trials, const std::function<void(std::vector<int>&)>& shuffle) {
+	std::vector<long long> counts(size * size, 0);
+	std::vector<int> values(size);
+	for (long long trial = 0; trial < trials; trial++) {
+		for (int i = 0; i < size; i++) {
+			values[i] = i;
+		}
+
+		shuffle(values);
+		for (int position = 0; position < size; position++) {
+			counts[values[position] * size + position]++;
+		}
+	}
+
+	double expected = static_cast<double>(trials) / size;
+	double chiSquare = 0;
+	for (long long count : counts) {
+		double difference = count - expected;
+		chiSquare += difference * difference / expected;
+	}
+
+	return { chiSquare, (size - 1) * (size - 1) };
+}
+
+/// <summary>
+/// Returns a shuffle for ChiSquarePositionTest that copies the values into a linkedList, shuffles it with listShuffle and copies them back.
+/// </summary>
+std::function<void(std::vector<int>&)> ListShuffleForTest(Random& random, void (*listShuffle)(linkedList<int>&, Random&)) {
+	return [&random, listShuffle](std::vector<int>& values) {
+		linkedList<int> list;
+		for (int value : values) {
+			list.Add(value);
+		}
+
+		listShuffle(list, random);
+		int i = 0;
+		for (element<int>* current = list.First(); !current->IsEnd(); element<int>::Inc(current)) {
+			values[i++] = current->value;
+		}
+	};
+}
+
+void PrintChiSquare(const std::string& name, const ChiSquareResult& result) {
+	std::cout << name << ": chi-square " << result.chiSquare << " (df " << result.degreesOfFreedom << ", z " << result.ZScore() << ") " << (result.Uniform() ? "uniform" : "BIASED") << "\n";
+}
+
+/// <summary>
+/// Times the original swap shuffle against the Fisher-Yates shuffle for linkedLists of several sizes and for the deck,
+///		then checks that each shuffle is uniform with a chi-square test.
+/// SwapShuffle with a single pass is the control the test has to reject.  Its default 10 passes hide the bias below what
+///		even 10^6 shuffles can detect in positions, so the control uses 1.
+/// </summary>
+void RunShuffleBenchmark(long long chiSquareTrials = 100000) {
+	Random random(12345);
+	void (*onePassSwapShuffle)(linkedList<int>&, Random&) = [](linkedList<int>& list, Random& random) { list.SwapShuffle(random, 1); };
+	void (*fisherYatesShuffle)(linkedList<int>&, Random&) = [](linkedList<int>& list, Random& random) { list.Shuffle(random); };
+
+	std::cout << "Shuffle time per call:\n";
+	const int sizes[] = { 52, 500, 5000 };
+	for (int size : sizes) {
+		linkedList<int> list;
+		for (int i = 0; i < size; i++) {
+			list.Add(i);
+		}
+
+		long long iterations = 2000000 / size;
+		double swapTime = TimeShuffle(std::max(1LL, iterations / size), [&] { list.SwapShuffle(random); });
+		double fisherYatesTime = TimeShuffle(iterations, [&] { list.Shuffle(random); });
+		std::cout << "linkedList<int> (" << size << "): SwapShuffle " << swapTime << " ns, Shuffle " << fisherYatesTime << " ns (" << swapTime / fisherYatesTime << "x faster)\n";
+	}
+
+	long long deckIterations = 100000;
+	double oldDeckTime = TimeShuffle(deckIterations, [&] {
+		std::unique_ptr<linkedList<Card>> deckList = CreateListDeck();
+		deckList->SwapShuffle(random);
+		std::stack<Card> deck = deckList->ToStack();
+	});
+
+	GameState game;
+	double newDeckTime = TimeShuffle(deckIterations, [&] { game.CreateAndShuffleDeck(); });
+	std::cout << "Deck: CreateListDeck + SwapShuffle + ToStack " << oldDeckTime << " ns, CreateAndShuffleDeck " << newDeckTime << " ns (" << oldDeckTime / newDeckTime << "x faster)\n\n";
+
+	std::cout << "Uniformity (" << chiSquareTrials << " shuffles of " << DECK_SIZE << " values):\n";
+	ChiSquareResult control = ChiSquarePositionTest(DECK_SIZE, chiSquareTrials, ListShuffleForTest(random, onePassSwapShuffle));
+	PrintChiSquare("linkedList SwapShuffle, 1 pass (control)", control);
+	PrintChiSquare("linkedList Shuffle", ChiSquarePositionTest(DECK_SIZE, chiSquareTrials, ListShuffleForTest(random, fisherYatesShuffle)));
+
+	//Shuffles the real Deck the game uses, and counts which CardID lands in each position.
+	Deck deck;
+	PrintChiSquare("Deck::Shuffle", ChiSquarePositionTest(DECK_SIZE, chiSquareTrials, [&](std::vector<int>& values) {
+		deck.Shuffle(random);
+		for (int position = 0; position < DECK_SIZE; position++) {
+			values[position] = deck.cards[position].CardID;
+		}
+	}));
+
+	if (control.Uniform())
+		std::cout << "The biased control wasn't rejected.  Use more trials.\n";
+}
+
+#pragma endregion
\ No newline at end of file
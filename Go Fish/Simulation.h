@@ -0,0 +1,267 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <ctime>
+#include <atomic>
+#include <mutex>
+#include <algorithm>
+#include <memory>
+#include "ConstantsAndGlobals.h"
+#include "GameState.h"
+#include "NPCFactory.h"
+#include "ThreadPool.h"
+#include "Tracer.h"
+#include "GameLog.h"
+
+#pragma region Headless Simulation
+
+/// <summary>
+/// Options for the headless simulation, set from the command line.
+/// </summary>
+struct SimulationOptions {
+	bool simulate = false;
+	bool tournament = false;
+	long long games = 1000000;
+	int numberOfPlayers = MIN_PLAYERS;
+	bool fixedPlayerCount = false;//Set by --players.  Otherwise a tournament plays every player count.
+	int threads = 0;//0 uses one thread per hardware thread.
+	bool bitboardHands = false;//If true, hands are BitboardHands instead of ListHands.
+	uint64_t seed = static_cast<uint64_t>(std::time(nullptr));
+	long long replayGame = -1;//If not -1, only this game number is played and every guess in it is printed.
+	std::string benchmark = "";//Name of the benchmark to run instead of playing, if any.
+	std::vector<std::string> strategies;//NPC strategy for each seat by player number.  Seats past the end are played by RandomizerAI.
+	std::string tracePath = "";//If set, games, turns, NPC decisions and guess resolutions are traced and written here as Chrome trace JSON.
+	long long traceEventsPerThread = 1 << 20;//Each thread keeps this many of its most recent trace events.
+	std::string logPath = "";//If set, every game is written to a binary game log.  Each worker writes its own shard, logPath.(worker).
+	std::string replayLogPath = "";//If set, the game log here is replayed and checked instead of playing.
+	ISMCTSSettings ismcts;//Search budget for seats played by ISMCTSAI.
+
+	/// <summary>
+	/// Gets the name of the strategy playing seat playerNumber.
+	/// </summary>
+	std::string Strategy(int playerNumber) const {
+		return playerNumber < static_cast<int>(strategies.size()) ? strategies[playerNumber] : "random";
+	}
+};
+
+/// <summary>
+/// Aggregate results of every game played by the headless simulation.
+/// </summary>
+struct SimulationResults {
+	SimulationResults(int numberOfPlayers = 0) : wins(numberOfPlayers), fourOfAKinds(numberOfPlayers) {}
+
+	long long games = 0;
+	long long draws = 0;
+	long long turns = 0;
+	long long turnLoopAllocations = 0;//Global allocations made by linkedLists while turns were being played.
+	long long loggedBytes = 0;//Bytes written to the game log shards.
+	int logShards = 0;
+	int failedLogShards = 0;//Shards that couldn't be created or completely written.
+	std::vector<long long> wins;//Outright wins per player number.  Draws are only counted in draws.
+	std::vector<long long> fourOfAKinds;//Total four of a kinds turned in per player number.
+
+	/// <summary>
+	/// Adds the results from another thread into these results.
+	/// </summary>
+	void Merge(const SimulationResults& other) {
+		games += other.games;
+		draws += other.draws;
+		turns += other.turns;
+		turnLoopAllocations += other.turnLoopAllocations;
+		loggedBytes += other.loggedBytes;
+		logShards += other.logShards;
+		failedLogShards += other.failedLogShards;
+		for (int i = 0; i < static_cast<int>(wins.size()); i++) {
+			wins[i] += other.wins[i];
+			fourOfAKinds[i] += other.fourOfAKinds[i];
+		}
+	}
+};
+
+/// <summary>
+/// Names used when printing a headless game.  Headless players are named "Player (number)".
+/// </summary>
+std::string HeadlessPlayerName(int playerNumber) {
+	return "Player " + std::to_string(playerNumber);
+}
+
+/// <summary>
+/// Gets the seed for game number gameNumber of a simulation.  Each game has its own seed so any single game can be
+///		reproduced from the simulation seed and its game number, no matter how many threads played the simulation.
+/// </summary>
+uint64_t GameSeed(uint64_t simulationSeed, long long gameNumber) {
+	return Random::StreamSeed(simulationSeed, static_cast<uint64_t>(gameNumber));
+}
+
+/// <summary>
+/// Creates the headless players and gives each seat its NPC strategy.
+/// </summary>
+template<typename GameType>
+void SetupHeadlessPlayers(GameType& game, const SimulationOptions& options) {
+	game.PopulatePlayers(options.numberOfPlayers, HeadlessPlayerName(0));
+	for (int i = 0; i < options.numberOfPlayers; i++) {
+		SetStrategy(game, i, options.Strategy(i), options.ismcts);
+	}
+}
+
+/// <summary>
+/// Gets the path of the game log shard written by worker.
+/// </summary>
+std::string GameLogShardPath(const std::string& logPath, int worker) {
+	return logPath + "." + std::to_string(worker);
+}
+
+/// <summary>
+/// Plays a full game between NPCs without any console input or output and adds the outcome to results.
+/// If log isn't null, the game is written to it as game number gameNumber.
+/// </summary>
+template<typename GameType>
+void PlayHeadlessGame(GameType& game, uint64_t gameSeed, SimulationResults& results, GameLogWriter* log = nullptr, long long gameNumber = 0) {
+	game.StartGame(gameSeed);
+	if (log != nullptr)
+		log->BeginGame(gameNumber, game);
+
+	long long allocationsBefore = AllocationCounters::Current().GlobalAllocations();
+	long long turns = 0;
+	while (!game.GameOver()) {
+		TRACE_SCOPE(Turn, game.currentPlayer->value.playerNumber);
+		Guess guess = game.GetNPCGuess();
+		game.PlayGuess(guess);
+		if (log != nullptr)
+			log->AddGuess(guess);
+
+		turns++;
+	}
+
+	if (log != nullptr)
+		log->EndGame();
+
+	results.turnLoopAllocations += AllocationCounters::Current().GlobalAllocations() - allocationsBefore;
+
+	std::vector<int> winners = game.TallyScores();
+	results.games++;
+	results.turns += turns;
+	if (winners.size() == 1) {
+		results.wins[winners[0]]++;
+	}
+	else {
+		results.draws++;
+	}
+
+	for (int i = 0; i < static_cast<int>(game.Scores.size()); i++) {
+		results.fourOfAKinds[i] += game.Scores[i];
+	}
+}
+
+/// <summary>
+/// Plays options.games games on a thread pool.  Each worker owns its own GameState, results and game log shard, and takes
+/// batches of games from a shared counter so that threads finishing early keep working.
+/// </summary>
+template<typename GameType>
+SimulationResults RunGamesParallel(const SimulationOptions& options) {
+	const long long batchSize = 1024;
+	SimulationResults results(options.numberOfPlayers);
+	std::atomic<long long> nextGame(0);
+	std::mutex resultsMutex;
+
+	ThreadPool pool(options.threads);
+	for (int i = 0; i < pool.ThreadCount(); i++) {
+		pool.Enqueue([&, i] {
+			GameType game;
+			SetupHeadlessPlayers(game, options);
+			SimulationResults threadResults(options.numberOfPlayers);
+			std::unique_ptr<GameLogWriter> log;
+			if (!options.logPath.empty())
+				log = std::make_unique<GameLogWriter>(GameLogShardPath(options.logPath, i), options.numberOfPlayers, options.seed);
+			long long batchStart;
+			while ((batchStart = nextGame.fetch_add(batchSize)) < options.games) {
+				TRACE_SCOPE(Batch, batchStart);
+				long long batchEnd = std::min(batchStart + batchSize, options.games);
+				for (long long gameNumber = batchStart; gameNumber < batchEnd; gameNumber++) {
+					TRACE_SCOPE(Game, gameNumber);
+					PlayHeadlessGame(game, GameSeed(options.seed, gameNumber), threadResults, log.get(), gameNumber);
+				}
+			}
+
+			if (log != nullptr) {
+				threadResults.failedLogShards += log->Close() ? 0 : 1;
+				threadResults.logShards++;
+				threadResults.loggedBytes += log->bytes;
+			}
+
+			std::lock_guard<std::mutex> lock(resultsMutex);
+			results.Merge(threadResults);
+		});
+	}
+
+	pool.Wait();
+
+	return results;
+}
+
+/// <summary>
+/// Plays game number options.replayGame of the simulation and prints every guess so a single game can be inspected.
+/// </summary>
+template<typename GameType>
+void PrintHeadlessGame(const SimulationOptions& options) {
+	uint64_t gameSeed = GameSeed(options.seed, options.replayGame);
+	GameType game;
+	SetupHeadlessPlayers(game, options);
+	game.StartGame(gameSeed);
+	std::cout << "Game " << options.replayGame << " of seed " << options.seed << " (game seed " << gameSeed << ")\n\n";
+
+	while (!game.GameOver()) {
+		Guess guess = game.GetNPCGuess();
+		guess.PrintGuess(HeadlessPlayerName);
+		game.PlayGuess(guess);
+		guess.PrintResult(HeadlessPlayerName);
+	}
+
+	game.TallyScores();
+	for (int i = 0; i < static_cast<int>(game.Scores.size()); i++) {
+		std::cout << HeadlessPlayerName(i) << ": " << game.Scores[i] << "\n";
+	}
+}
+
+/// <summary>
+/// Plays options.games games between NPCs, then prints only the aggregate results.
+/// </summary>
+void RunSimulation(const SimulationOptions& options) {
+	if (options.replayGame != -1) {
+		if (options.bitboardHands) {
+			PrintHeadlessGame<BitboardGameState>(options);
+		}
+		else {
+			PrintHeadlessGame<GameState>(options);
+		}
+
+		return;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	SimulationResults results = options.bitboardHands ? RunGamesParallel<BitboardGameState>(options) : RunGamesParallel<GameState>(options);
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	double games = static_cast<double>(results.games);
+
+	int threads = options.threads > 0 ? options.threads : ThreadPool::DefaultThreadCount();
+	std::cout << "Games: " << results.games << ", Players: " << options.numberOfPlayers << ", Threads: " << threads << ", Hands: " << (options.bitboardHands ? "bitboard" : "list") << ", Seed: " << options.seed << "\n";
+	std::cout << "Time: " << seconds << "s (" << (seconds > 0 ? games / seconds : 0) << " games/s)\n";
+	std::cout << "Average turns per game: " << results.turns / games << "\n";
+	std::cout << "Global allocations by linkedLists during turns: " << results.turnLoopAllocations << "\n";
+	for (int i = 0; i < options.numberOfPlayers; i++) {
+		std::cout << "Player " << i << " (" << options.Strategy(i) << "): " << 100.0 * results.wins[i] / games << "% wins, " << results.fourOfAKinds[i] / games << " four of a kinds per game\n";
+	}
+
+	std::cout << "Draws: " << 100.0 * results.draws / games << "%\n";
+	if (!options.logPath.empty()) {
+		std::cout << "Game log: " << results.loggedBytes << " bytes (" << results.loggedBytes / std::max(1.0, games) << " per game) in " << results.logShards
+			<< " shards, " << GameLogShardPath(options.logPath, 0) << " to " << GameLogShardPath(options.logPath, results.logShards - 1) << "\n";
+		if (results.failedLogShards > 0)
+			std::cout << results.failedLogShards << " game log shards couldn't be completely written.\n";
+	}
+}
+
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <algorithm>
+#include "ConstantsAndGlobals.h"
+#include "GameState.h"
+#include "GameSnapshot.h"
+#include "GuessJournal.h"
+#include "Simulation.h"
+#include "IteratorBenchmark.h"
+
+#pragma region Snapshot Benchmark
+
+/// <summary>
+/// Plays NPC guesses until the game is over and returns the number of guesses played.
+/// </summary>
+template<typename GameType>
+int PlayToEnd(GameType& game) {
+	int turns = 0;
+	while (!game.GameOver()) {
+		Guess guess = game.GetNPCGuess();
+		game.PlayGuess(guess);
+		turns++;
+	}
+
+	return turns;
+}
+
+/// <summary>
+/// Checks that restoring a snapshot taken partway through a game and playing on gives exactly the same game as playing on
+///		without it, then times SaveSnapshot and Restore on a position from the middle of a game.
+/// </summary>
+template<typename GameType>
+void BenchmarkSnapshots(const std::string& name, int numberOfPlayers, int games) {
+	GameType game;
+	game.PopulatePlayers(numberOfPlayers, HeadlessPlayerName(0));
+	int mismatches = 0;
+	for (int gameNumber = 0; gameNumber < games; gameNumber++) {
+		game.StartGame(GameSeed(1, gameNumber));
+		for (int i = 0; i < gameNumber % 20 && !game.GameOver(); i++) {
+			Guess guess = game.GetNPCGuess();
+			game.PlayGuess(guess);
+		}
+
+		GameSnapshot snapshot = game.Snapshot();
+		int turns = PlayToEnd(game);
+		int fourOfAKinds[CARDS_PER_SUIT];
+		std::copy(std::begin(game.FourOfAKinds), std::end(game.FourOfAKinds), fourOfAKinds);
+
+		game.Restore(snapshot);
+		if (PlayToEnd(game) != turns || !std::equal(std::begin(fourOfAKinds), std::end(fourOfAKinds), std::begin(game.FourOfAKinds)))
+			mismatches++;
+	}
+
+	//Alternate between two positions so Restore always has something to change.
+	game.StartGame(GameSeed(2, 0));
+	GameSnapshot start = game.Snapshot();
+	for (int i = 0; i < 10 && !game.GameOver(); i++) {
+		Guess guess = game.GetNPCGuess();
+		game.PlayGuess(guess);
+	}
+
+	GameSnapshot middle = game.Snapshot();
+	GameSnapshot saved;
+	int repetitions = 1000000;
+	double saveTime = TimeRepetitions(repetitions, [&] { game.SaveSnapshot(saved); });
+	int restores = 0;
+	double restoreTime = TimeRepetitions(repetitions, [&] { game.Restore(restores++ % 2 == 0 ? start : middle); });
+
+	std::cout << name << " (" << numberOfPlayers << " players): SaveSnapshot " << saveTime << " ns, Restore " << restoreTime << " ns, "
+		<< games - mismatches << "/" << games << " restored games played out the same\n";
+}
+
+/// <summary>
+/// Checks that making a line of up to 40 guesses and unmaking them all puts every game back exactly how it was,
+///		then times making and unmaking one guess from the middle of a game.
+/// </summary>
+template<typename GameType>
+void BenchmarkMakeUnmake(const std::string& name, int numberOfPlayers, int games) {
+	GameType game;
+	game.PopulatePlayers(numberOfPlayers, HeadlessPlayerName(0));
+	GuessJournal journal;
+	int mismatches = 0;
+	for (int gameNumber = 0; gameNumber < games; gameNumber++) {
+		game.StartGame(GameSeed(3, gameNumber));
+		GameSnapshot before = game.Snapshot();
+		for (int i = 0; i < 40 && !game.GameOver(); i++) {
+			Guess guess = game.GetNPCGuess();
+			game.MakeGuess(guess, journal);
+		}
+
+		game.UnmakeTo(journal, 0);
+
+		//NPC guesses use random, which unmaking doesn't undo.
+		GameSnapshot after = game.Snapshot();
+		after.random = before.random;
+		if (after != before)
+			mismatches++;
+	}
+
+	game.StartGame(GameSeed(4, 0));
+	for (int i = 0; i < 10 && !game.GameOver(); i++) {
+		Guess guess = game.GetNPCGuess();
+		game.PlayGuess(guess);
+	}
+
+	Guess guess = game.GetNPCGuess();
+	int repetitions = 1000000;
+	double makeUnmakeTime = TimeRepetitions(repetitions, [&] {
+		Guess copy = guess;
+		game.MakeGuess(copy, journal);
+		game.UnmakeGuess(journal);
+	});
+
+	std::cout << name << " (" << numberOfPlayers << " players): MakeGuess + UnmakeGuess " << makeUnmakeTime << " ns, "
+		<< games - mismatches << "/" << games << " games unmade back to the start\n";
+}
+
+/// <summary>
+/// Times snapshots and make/unmake on list and bitboard games and checks that both put the game back exactly.
+/// </summary>
+void RunSnapshotBenchmark() {
+	std::cout << "GameSnapshot is " << sizeof(GameSnapshot) << " bytes (" << sizeof(GameSnapshot) / 64 << " cache lines)\n";
+	const int playerCounts[] = { 2, 6 };
+	for (int numberOfPlayers : playerCounts) {
+		BenchmarkSnapshots<GameState>("List hands", numberOfPlayers, 10000);
+		BenchmarkSnapshots<BitboardGameState>("Bitboard hands", numberOfPlayers, 10000);
+		BenchmarkMakeUnmake<GameState>("List hands", numberOfPlayers, 10000);
+		BenchmarkMakeUnmake<BitboardGameState>("Bitboard hands", numberOfPlayers, 10000);
+	}
+}
+
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include "ConstantsAndGlobals.h"
+#include "linkedList.h"
+#include "Card.h"
+#include "ListHand.h"
+#include "Random.h"
+#include "NodePool.h"
+#include "IteratorBenchmark.h"
+
+#pragma region Sort Benchmark
+
+/// <summary>
+/// Checks that every value in the list is >= the one before it.
+/// </summary>
+bool IsSorted(linkedList<int>& list) {
+	return std::is_sorted(list.begin(), list.end());
+}
+
+/// <summary>
+/// Times the original insertion sort against the merge sort on shuffled linkedLists of several sizes,
+///		then times dealing an opening hand one card at a time against one AddBatch.
+/// </summary>
+void RunSortBenchmark() {
+	Random random(12345);
+	bool allSorted = true;
+	const int sizes[] = { 7, 52, 1000, 10000, 100000 };
+
+	std::cout << "Shuffle + sort time per call in microseconds (InsertionSort / Sort):\n";
+	for (int size : sizes) {
+		linkedList<int> list;
+		for (int i = 0; i < size; i++) {
+			list.Add(random.NextInt(size));
+		}
+
+		int repetitions = std::max(3, 2000000 / size);
+		double shuffleOnly = TimeRepetitions(repetitions, [&] { list.Shuffle(random); });
+		double mergeSort = TimeRepetitions(repetitions, [&] {
+			list.Shuffle(random);
+			list.Sort();
+		});
+
+		allSorted &= IsSorted(list);
+		mergeSort -= shuffleOnly;
+		std::cout << "Size " << size << ": ";
+
+		//Insertion sort takes minutes at 100,000.
+		if (size <= 10000) {
+			int insertionRepetitions = std::max(1, repetitions / std::max(1, size / 52));
+			double insertionSort = TimeRepetitions(insertionRepetitions, [&] {
+				list.Shuffle(random);
+				list.InsertionSort();
+			}) - shuffleOnly;
+
+			allSorted &= IsSorted(list);
+			std::cout << insertionSort / 1000 << " / " << mergeSort / 1000 << " (" << insertionSort / mergeSort << "x)\n";
+		}
+		else {
+			std::cout << "skipped / " << mergeSort / 1000 << "\n";
+		}
+	}
+
+	Card cards[DECK_SIZE];
+	for (int i = 0; i < DECK_SIZE; i++) {
+		cards[i] = Card(i % CARDS_PER_SUIT, i / CARDS_PER_SUIT);
+	}
+
+	//Use a pool like the game does so the allocator doesn't hide the difference.
+	int dealRepetitions = 1000000;
+	NodePool<element<Card>> pool(DECK_SIZE);
+	ListHand hand;
+	hand.SetPool(&pool);
+	double oneAtATime = TimeRepetitions(dealRepetitions, [&] {
+		FisherYatesShuffle(cards, random);
+		for (int i = 0; i < 7; i++) {
+			hand.AddCard(cards[i]);
+		}
+
+		hand.Clear();
+	});
+
+	double batch = TimeRepetitions(dealRepetitions, [&] {
+		FisherYatesShuffle(cards, random);
+		hand.AddCards(cards, 7);
+		hand.Clear();
+	});
+
+	hand.AddCards(cards, 7);
+	allSorted &= std::is_sorted(hand.begin(), hand.end());
+
+	std::cout << "\nShuffle + deal a 7 card hand + clear: AddCard x 7 " << oneAtATime << " ns, AddCards " << batch << " ns (" << oneAtATime / batch << "x)\n";
+	std::cout << (allSorted ? "All results sorted.\n" : "NOT SORTED.\n");
+}
+
+#pragma endregion
\ No newline at end of file
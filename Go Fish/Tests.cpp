@@ -0,0 +1,540 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <bit>
+#include <stdexcept>
+#include <initializer_list>
+#include "ConstantsAndGlobals.h"
+#include "linkedList.h"
+#include "NodePool.h"
+#include "GameState.h"
+#include "GameSnapshot.h"
+#include "GuessJournal.h"
+#include "BitboardHand.h"
+#include "ListHand.h"
+#include "GameLog.h"
+#include "Random.h"
+#include "Guess.h"
+#include "NPC.h"
+
+#pragma region Checks
+
+int failures = 0;
+
+void Check(bool passed, const std::string& name) {
+	std::cout << (passed ? "PASS " : "FAIL ") << name << "\n";
+	if (!passed)
+		failures++;
+}
+
+/// <summary>
+/// Walks the list checking that every element, including the end element, points back at the list and at the element
+///		before it, and that count matches the number of elements.
+/// </summary>
+template<typename T>
+bool LinksValid(const linkedList<T>& list) {
+	int count = 0;
+	element<T>* previous = nullptr;
+	element<T>* current = list.First();
+	for (; !current->IsEnd(); current = current->nextElement) {
+		if (current->previousElement != previous || current->list != &list)
+			return false;
+
+		previous = current;
+		count++;
+	}
+
+	return current == list.End() && current->previousElement == previous && current->list == &list && count == list.Count();
+}
+
+/// <summary>
+/// Checks that operator[] finds every element in order, which rebuilds the index on indexed lists.
+/// </summary>
+template<typename T>
+bool LookupsMatch(linkedList<T>& list) {
+	std::vector<T> values = list.ToVector();
+	for (int i = 0; i < list.Count(); i++) {
+		if (list[i]->value != values[i])
+			return false;
+	}
+
+	return true;
+}
+
+#pragma endregion
+
+#pragma region Splicing
+
+linkedList<int> IndexedList(const std::vector<int>& values) {
+	linkedList<int> list;
+	list.SetIndexed(true);
+	for (int value : values) {
+		list.Add(value);
+	}
+
+	list[0];//Build the index so the splice has to invalidate it.
+
+	return list;
+}
+
+/// <summary>
+/// Splices between two indexed lists and checks both lists' count, order, back pointers and indexed lookups afterwards.
+/// </summary>
+void TestSplice() {
+	linkedList<int> source = IndexedList({ 1, 2, 3, 4, 5 });
+	linkedList<int> destination = IndexedList({ 10, 20, 30 });
+	int moved = destination.Splice(destination[1], source, source[1], source[4]);
+	Check(moved == 3 && source.ToVector() == std::vector<int>{ 1, 5 } && destination.ToVector() == std::vector<int>{ 10, 2, 3, 4, 20, 30 },
+		"Splice moves a run from the middle of one list into the middle of another");
+	Check(LinksValid(source) && LinksValid(destination) && LookupsMatch(source) && LookupsMatch(destination),
+		"Splice leaves both lists' links, counts and indexes right");
+
+	moved = destination.Splice(destination.First(), source, source.First(), source.End());
+	Check(moved == 2 && source.Count() == 0 && source.First() == source.End() && destination.ToVector() == std::vector<int>{ 1, 5, 10, 2, 3, 4, 20, 30 },
+		"Splice of a whole list to the front empties the source");
+	Check(LinksValid(source) && LinksValid(destination) && LookupsMatch(destination), "Splice of a whole list leaves both lists' links right");
+
+	destination.Splice(destination.End(), destination, destination.First());
+	Check(destination.ToVector() == std::vector<int>{ 5, 10, 2, 3, 4, 20, 30, 1 } && LinksValid(destination) && LookupsMatch(destination),
+		"Splice of a single element within a list moves it to the end");
+
+	Check(source.Splice(source.End(), destination, destination[2], destination[2]) == 0 && destination.Count() == 8 && LinksValid(destination),
+		"Splice of an empty range moves nothing");
+
+	NodePool<element<int>> pool(8);
+	linkedList<int> pooled;
+	pooled.SetPool(&pool);
+	bool threw = false;
+	try {
+		pooled.Splice(pooled.End(), destination, destination.First());
+	}
+	catch (const std::logic_error&) {
+		threw = true;
+	}
+
+	Check(threw && pooled.Count() == 0 && destination.Count() == 8 && LinksValid(destination), "Splice between lists with different pools throws and moves nothing");
+}
+
+/// <summary>
+/// SpliceSorted merges the run into a sorted list in place and adds it to the end of an unsorted one.
+/// </summary>
+void TestSpliceSorted() {
+	linkedList<int> source(nullptr, true);
+	linkedList<int> destination(nullptr, true);
+	source.SetIndexed(true);
+	destination.SetIndexed(true);
+	for (int value : { 1, 3, 3, 5, 7, 9 }) {
+		source.Add(value);
+	}
+
+	for (int value : { 0, 3, 4, 8 }) {
+		destination.Add(value);
+	}
+
+	source[0];
+	destination[0];
+	int moved = destination.SpliceSorted(source, source[1], source[5]);
+	Check(moved == 4 && source.ToVector() == std::vector<int>{ 1, 9 } && destination.ToVector() == std::vector<int>{ 0, 3, 3, 3, 4, 5, 7, 8 },
+		"SpliceSorted merges a run into a sorted list");
+	Check(LinksValid(source) && LinksValid(destination) && LookupsMatch(source) && LookupsMatch(destination),
+		"SpliceSorted leaves both lists' links, counts and indexes right");
+
+	//The 3 that was already in destination has to stay before the ones merged in.
+	element<int>* firstThree = destination[1];
+	linkedList<int> other(nullptr, true);
+	other.Add(3);
+	destination.SpliceSorted(other, other.First(), other.End());
+	Check(destination[1] == firstThree && destination.ToVector() == std::vector<int>{ 0, 3, 3, 3, 3, 4, 5, 7, 8 } && LinksValid(destination) && LinksValid(other),
+		"SpliceSorted puts equal values after the ones already in the list");
+
+	linkedList<int> unsorted = IndexedList({ 6, 2 });
+	moved = unsorted.SpliceSorted(destination, destination.First(), destination[2]);
+	Check(moved == 2 && unsorted.ToVector() == std::vector<int>{ 6, 2, 0, 3 } && LinksValid(unsorted) && LinksValid(destination) && LookupsMatch(unsorted),
+		"SpliceSorted adds the run to the end of an unsorted list");
+}
+
+#pragma endregion
+
+#pragma region Sorting
+
+/// <summary>
+/// Compares by key only, so values with equal keys can be told apart by order to check that sorting is stable.
+/// </summary>
+struct KeyedValue {
+	int key;
+	int order;
+
+	bool operator<(const KeyedValue& other) const { return key < other.key; }
+	bool operator>(const KeyedValue& other) const { return key > other.key; }
+	bool operator<=(const KeyedValue& other) const { return key <= other.key; }
+	bool operator>=(const KeyedValue& other) const { return key >= other.key; }
+	bool operator==(const KeyedValue& other) const { return key == other.key; }
+	bool operator!=(const KeyedValue& other) const { return key != other.key; }
+};
+
+/// <summary>
+/// Makes count values with keys from 0 to keys - 1 in a random order, numbered by the order they were made in.
+/// </summary>
+std::vector<KeyedValue> RandomKeyedValues(int count, int keys, Random& random) {
+	std::vector<KeyedValue> values;
+	for (int i = 0; i < count; i++) {
+		values.push_back({ random.NextInt(keys), i });
+	}
+
+	return values;
+}
+
+/// <summary>
+/// Checks the list's keys are in order and equal keys are in the order they were made in.
+/// </summary>
+bool SortedStably(const linkedList<KeyedValue>& list) {
+	std::vector<KeyedValue> values = list.ToVector();
+	for (int i = 1; i < static_cast<int>(values.size()); i++) {
+		if (values[i].key < values[i - 1].key || (values[i].key == values[i - 1].key && values[i].order < values[i - 1].order))
+			return false;
+	}
+
+	return true;
+}
+
+/// <summary>
+/// Sort on empty and 1 element lists and on sizes either side of the insertion sort cutoff (8) used by MergeSortChain.
+/// </summary>
+void TestSort() {
+	Random random(2);
+	for (int size : { 0, 1, 2, 7, 8, 9, 16, 17, 100, 1000 }) {
+		linkedList<KeyedValue> list;
+		for (const KeyedValue& value : RandomKeyedValues(size, 5, random)) {
+			list.Add(value);
+		}
+
+		list.Sort();
+		Check(SortedStably(list) && LinksValid(list) && list.Count() == size, "Sort " + std::to_string(size) + " values is stable and relinks every element");
+
+		list.Add({ 2, size });
+		Check(SortedStably(list) && LinksValid(list), "Sort " + std::to_string(size) + " values leaves the list sorted for Add");
+	}
+}
+
+/// <summary>
+/// AddBatch into empty and non empty sorted lists with batches either side of the insertion sort cutoff.
+/// Values equal to ones already in the list go after them, and equal values in the batch keep their order.
+/// </summary>
+void TestAddBatch() {
+	Random random(3);
+	for (int existing : { 0, 1, 9 }) {
+		for (int size : { 0, 1, 8, 9, 50 }) {
+			linkedList<KeyedValue> list(nullptr, true);
+			for (int i = 0; i < existing; i++) {
+				list.Add({ random.NextInt(5), i - existing });
+			}
+
+			std::vector<KeyedValue> batch = RandomKeyedValues(size, 5, random);
+			list.AddBatch(batch.data(), size);
+			std::string name = "AddBatch " + std::to_string(size) + " values to a list of " + std::to_string(existing);
+			Check(SortedStably(list) && LinksValid(list) && list.Count() == existing + size, name + " is stable and links every element");
+		}
+	}
+
+	linkedList<int> unsorted;
+	const int values[] = { 5, 1, 4 };
+	unsorted.AddBatch(values, 3);
+	Check(unsorted.ToVector() == std::vector<int>{ 5, 1, 4 } && LinksValid(unsorted), "AddBatch adds to the end of an unsorted list in order");
+}
+
+#pragma endregion
+
+#pragma region Snapshots
+
+/// <summary>
+/// Plays guesses until the game is over or turns guesses have been played.
+/// </summary>
+template<typename GameType>
+void PlayTurns(GameType& game, int turns) {
+	for (int i = 0; i < turns && !game.GameOver(); i++) {
+		Guess guess = game.GetNPCGuess();
+		game.PlayGuess(guess);
+	}
+}
+
+/// <summary>
+/// Restoring a snapshot from the middle of a game puts back the exact position, which then plays out the same as it did the
+///		first time.  A snapshot restores into either hand type, and restoring into a game with a different number of players throws.
+/// </summary>
+template<typename GameType, typename OtherGameType>
+void TestSnapshotRoundTrip(const std::string& name) {
+	for (int numberOfPlayers : { 2, 4, 6 }) {
+		std::string players = " (" + std::to_string(numberOfPlayers) + " players)";
+		GameType game;
+		game.PopulatePlayers(numberOfPlayers, "Player 0");
+		game.StartGame(11);
+		PlayTurns(game, 15);
+		GameSnapshot saved = game.Snapshot();
+		PlayTurns(game, 1000);
+		GameSnapshot finished = game.Snapshot();
+
+		game.Restore(saved);
+		Check(game.Snapshot() == saved, name + " Restore puts the position back exactly" + players);
+
+		PlayTurns(game, 1000);
+		Check(game.Snapshot() == finished, name + " restored game plays out the same" + players);
+
+		OtherGameType other;
+		other.PopulatePlayers(numberOfPlayers, "Player 0");
+		other.Restore(saved);
+		Check(other.Snapshot() == saved, name + " snapshot restores into the other hand type" + players);
+
+		GameType wrongPlayers;
+		wrongPlayers.PopulatePlayers(numberOfPlayers == 2 ? 3 : 2, "Player 0");
+		bool threw = false;
+		try {
+			wrongPlayers.Restore(saved);
+		}
+		catch (const std::logic_error&) {
+			threw = true;
+		}
+
+		Check(threw, name + " Restore into a game with a different number of players throws" + players);
+	}
+}
+
+/// <summary>
+/// Makes up to guesses guesses, checking after each that the depth grew by one, then unmakes them all.
+/// Checks hands, the deck's drawIndex, FourOfAKinds, currentPlayer and lastGuesses are all back exactly, and that each ListHand's
+///		card number counts agree with its cards.
+/// </summary>
+template<typename GameType>
+void TestMakeUnmake(const std::string& name) {
+	for (int numberOfPlayers : { 2, 6 }) {
+		std::string players = " (" + std::to_string(numberOfPlayers) + " players)";
+		GameType game;
+		game.PopulatePlayers(numberOfPlayers, "Player 0");
+		GuessJournal journal;
+		bool depthsRight = true;
+		bool restored = true;
+		bool countsRight = true;
+		bool sawFourOfAKind = false;
+		for (uint64_t seed = 0; seed < 50; seed++) {
+			game.StartGame(seed);
+			PlayTurns(game, static_cast<int>(seed % 20));
+			uint64_t hands[MAX_PLAYERS];
+			for (int player = 0; player < numberOfPlayers; player++) {
+				hands[player] = game.players[player]->value.hand.Cards();
+			}
+
+			int drawIndex = game.deck.drawIndex;
+			int fourOfAKinds[CARDS_PER_SUIT];
+			std::copy(std::begin(game.FourOfAKinds), std::end(game.FourOfAKinds), std::begin(fourOfAKinds));
+			element<typename GameType::PlayerType>* currentPlayer = game.currentPlayer;
+			std::vector<Guess> lastGuesses = game.lastGuesses;
+
+			for (int i = 0; i < 60 && !game.GameOver(); i++) {
+				Guess guess = game.GetNPCGuess();
+				game.MakeGuess(guess, journal);
+				depthsRight &= journal.Depth() == i + 1;
+				sawFourOfAKind |= guess.guessResult == GuessResultID::Success4OfAKind || guess.guessResult == GuessResultID::GoFish4OfAKind;
+			}
+
+			game.UnmakeTo(journal, 0);
+			restored &= journal.Depth() == 0 && game.deck.drawIndex == drawIndex && game.currentPlayer == currentPlayer
+				&& std::equal(std::begin(fourOfAKinds), std::end(fourOfAKinds), std::begin(game.FourOfAKinds));
+			for (int player = 0; player < numberOfPlayers; player++) {
+				const auto& hand = game.players[player]->value.hand;
+				restored &= hand.Cards() == hands[player];
+				const Guess& before = lastGuesses[player];
+				const Guess& after = game.lastGuesses[player];
+				restored &= before.targetPlayerNumber == after.targetPlayerNumber && before.currentPlayerNumber == after.currentPlayerNumber
+					&& before.card.CardID == after.card.CardID && before.guessResult == after.guessResult && before.numberOfCardsRecieved == after.numberOfCardsRecieved;
+				for (int cardNumber = 0; cardNumber < CARDS_PER_SUIT; cardNumber++) {
+					countsRight &= hand.CountOfNumber(cardNumber) == std::popcount(hand.Cards() & BitboardHand::NumberMask(cardNumber));
+				}
+			}
+		}
+
+		Check(depthsRight, name + " MakeGuess pushes one entry per guess" + players);
+		Check(sawFourOfAKind, name + " make/unmake games include a four of a kind" + players);
+		Check(restored, name + " UnmakeTo(journal, 0) puts back hands, drawIndex, FourOfAKinds, currentPlayer and lastGuesses" + players);
+		Check(countsRight, name + " hand counts agree with the cards after unmaking" + players);
+	}
+}
+
+#pragma endregion
+
+#pragma region ListHand
+
+/// <summary>
+/// Checks the O(1) counts ListHand keeps for each card number against the cards actually in the hand.
+/// </summary>
+bool CountsMatch(const ListHand& hand) {
+	int counts[CARDS_PER_SUIT] = {};
+	for (const Card& card : hand) {
+		counts[card.CardNumber()]++;
+	}
+
+	uint16_t held = 0;
+	for (int cardNumber = 0; cardNumber < CARDS_PER_SUIT; cardNumber++) {
+		if (hand.CountOfNumber(cardNumber) != counts[cardNumber] || hand.HasNumber(cardNumber) != (counts[cardNumber] > 0))
+			return false;
+
+		if (counts[cardNumber] > 0)
+			held |= 1 << cardNumber;
+	}
+
+	return hand.HeldNumbers() == held;
+}
+
+ListHand HandOf(std::initializer_list<int> cardIDs) {
+	ListHand hand;
+	for (int cardID : cardIDs) {
+		hand.AddCard(Card(cardID));
+	}
+
+	return hand;
+}
+
+/// <summary>
+/// Every ListHand operation that changes the cards has to keep the card number counts right.
+/// </summary>
+void TestListHandCounts() {
+	//Card numbers: 0-3 are A's, 4-7 are 2's, 8-11 are 3's.
+	ListHand hand = HandOf({ 0, 1, 4, 8, 9, 10, 51 });
+	ListHand other = HandOf({ 2, 5, 11 });
+	Check(CountsMatch(hand) && CountsMatch(other), "ListHand AddCard counts cards");
+
+	int moved = hand.GiveAllOfNumber(2, other);
+	Check(moved == 3 && hand.CountOfNumber(2) == 0 && other.CountOfNumber(2) == 4 && CountsMatch(hand) && CountsMatch(other),
+		"ListHand GiveAllOfNumber moves the counts with the cards");
+	Check(hand.GiveAllOfNumber(2, other) == 0 && CountsMatch(hand) && CountsMatch(other), "ListHand GiveAllOfNumber of a number it doesn't have changes nothing");
+
+	other.RemoveAllOfNumber(2);
+	Check(other.CountOfNumber(2) == 0 && other.Count() == 2 && CountsMatch(other), "ListHand RemoveAllOfNumber clears the number's count");
+
+	hand.SetCards(1ull << 0 | 1ull << 3 | 1ull << 20 | 1ull << 21);
+	Check(hand.Cards() == (1ull << 0 | 1ull << 3 | 1ull << 20 | 1ull << 21) && CountsMatch(hand), "ListHand SetCards recounts the cards that changed");
+
+	hand.GiveCards(1ull << 3 | 1ull << 20, other);
+	hand.RemoveCards(1ull << 0);
+	Check(hand.Count() == 1 && other.Count() == 4 && CountsMatch(hand) && CountsMatch(other), "ListHand GiveCards and RemoveCards keep the counts");
+
+	ListHand copy(other);
+	ListHand assigned;
+	assigned = other;
+	Check(CountsMatch(copy) && CountsMatch(assigned) && copy.Cards() == other.Cards() && assigned.Cards() == other.Cards() && CountsMatch(other),
+		"ListHand copies have the same counts");
+
+	ListHand movedTo(std::move(copy));
+	Check(CountsMatch(movedTo) && movedTo.Cards() == other.Cards() && copy.Count() == 0 && CountsMatch(copy), "ListHand move constructor takes the counts");
+
+	assigned = std::move(movedTo);
+	Check(CountsMatch(assigned) && assigned.Cards() == other.Cards() && movedTo.Count() == 0 && CountsMatch(movedTo), "ListHand move assignment takes the counts");
+
+	ListHand& same = assigned;
+	assigned = std::move(same);
+	Check(assigned.Cards() == other.Cards() && CountsMatch(assigned), "ListHand moved into itself keeps its cards and counts");
+
+	assigned.Clear();
+	Check(assigned.Count() == 0 && CountsMatch(assigned), "ListHand Clear clears the counts");
+}
+
+#pragma endregion
+
+#pragma region Game Log
+
+bool SameGuess(const Guess& guess, const LoggedGuess& logged, int cardsReceived) {
+	return logged.CurrentPlayerNumber() == guess.currentPlayerNumber && logged.TargetPlayerNumber() == guess.targetPlayerNumber
+		&& logged.CardNumber() == guess.card.CardNumber() && logged.GuessResult() == guess.guessResult && logged.NumberOfCardsRecieved() == cardsReceived;
+}
+
+/// <summary>
+/// Every field of a LoggedGuess unpacks to what was packed, including an empty handed player being given all 4 cards of a number.
+/// </summary>
+void TestLoggedGuessPacking() {
+	Guess allFour(5, 4, 12, GuessResultID::Success4OfAKind, 4);
+	LoggedGuess logged = LoggedGuess::Pack(allFour);
+	Check(SameGuess(allFour, logged, 4), "LoggedGuess keeps a 4 card receive");
+
+	bool allSame = true;
+	for (int result = GuessResultID::FailGoFish; result <= GuessResultID::GoFish4OfAKind; result++) {
+		bool received = result == GuessResultID::Success || result == GuessResultID::Success4OfAKind;
+		for (int cards = 1; cards <= SUITS_PER_DECK; cards++) {
+			for (int cardNumber = 0; cardNumber < CARDS_PER_SUIT; cardNumber++) {
+				Guess guess(MAX_PLAYERS - 1 - cardNumber % MAX_PLAYERS, cardNumber % MAX_PLAYERS, cardNumber, result, cards);
+				allSame &= SameGuess(guess, LoggedGuess::Pack(guess), received ? cards : 0);
+			}
+		}
+	}
+
+	Check(allSame, "LoggedGuess unpacks every field it packs");
+}
+
+#pragma endregion
+
+#pragma region MemoryAI
+
+/// <summary>
+/// Starts a new game for memory where player 0 has askerHandSize cards and player 1 has 5.
+/// </summary>
+void StartMemoryGame(MemoryAI& memory, int askerHandSize) {
+	TableView table = {};
+	table.handSizes[0] = static_cast<uint8_t>(askerHandSize);
+	table.handSizes[1] = 5;
+	table.deckSize = 30;
+	table.playerCount = 2;
+	table.playerNumber = 1;
+	memory.NewGame();
+	memory.ObserveTable(table);
+}
+
+/// <summary>
+/// An empty handed asker can ask for any card number that hasn't been turned in, so the ask doesn't mean they hold one.
+/// </summary>
+void TestMemoryEmptyHandAsk() {
+	int fourOfAKinds[CARDS_PER_SUIT];
+	std::fill(std::begin(fourOfAKinds), std::end(fourOfAKinds), NO_PLAYER);
+	Random random(1);
+	MemoryAI memory(fourOfAKinds, random);
+	const int cardNumber = 3;
+
+	StartMemoryGame(memory, 0);
+	memory.ObserveGuess(Guess(1, 0, cardNumber, GuessResultID::FailGoFish));
+	Check(memory.minimumHeld[0][cardNumber] == 0, "MemoryAI empty hand ask that goes fish leaves minimumHeld at 0");
+
+	StartMemoryGame(memory, 0);
+	memory.ObserveGuess(Guess(1, 0, cardNumber, GuessResultID::Success, 2));
+	Check(memory.minimumHeld[0][cardNumber] == 2, "MemoryAI empty hand ask that succeeds only counts the cards received");
+
+	StartMemoryGame(memory, 4);
+	memory.ObserveGuess(Guess(1, 0, cardNumber, GuessResultID::FailGoFish));
+	Check(memory.minimumHeld[0][cardNumber] == 1, "MemoryAI ask from a hand with cards means the asker holds one");
+
+	//After going fish the asker holds the card they drew, so their next ask means something again.
+	StartMemoryGame(memory, 0);
+	memory.ObserveGuess(Guess(1, 0, cardNumber, GuessResultID::FailGoFish));
+	memory.ObserveGuess(Guess(0, 1, 5, GuessResultID::FailGoFish));
+	memory.ObserveGuess(Guess(1, 0, 7, GuessResultID::FailGoFish));
+	Check(memory.minimumHeld[0][7] == 1, "MemoryAI counts the card drawn by an empty handed asker");
+}
+
+#pragma endregion
+
+/// <summary>
+/// Runs every test.  Returns 1 if any failed.
+/// </summary>
+int main() {
+	TestSplice();
+	TestSpliceSorted();
+	TestSort();
+	TestAddBatch();
+	TestSnapshotRoundTrip<GameState, BitboardGameState>("GameState");
+	TestSnapshotRoundTrip<BitboardGameState, GameState>("BitboardGameState");
+	TestMakeUnmake<GameState>("GameState");
+	TestMakeUnmake<BitboardGameState>("BitboardGameState");
+	TestListHandCounts();
+	TestLoggedGuessPacking();
+	TestMemoryEmptyHandAsk();
+	std::cout << (failures == 0 ? "All tests passed.\n" : std::to_string(failures) + " test(s) failed.\n");
+
+	return failures == 0 ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+/// <summary>
+/// ThreadPool keeps a fixed number of worker threads that run queued tasks until the pool is destroyed.
+/// </summary>
+class ThreadPool {
+	ThreadPool(const ThreadPool& other) = delete;//Delete copy constructor to prevent copying ThreadPool objects.
+
+	std::vector<std::thread> workers;
+	std::queue<std::function<void()>> tasks;
+	std::mutex mutex;
+	std::condition_variable taskAvailable;
+	std::condition_variable allTasksDone;
+	int runningTasks = 0;
+	bool stopping = false;
+
+	void WorkerLoop() {
+		while (true) {
+			std::function<void()> task;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				taskAvailable.wait(lock, [this] { return stopping || !tasks.empty(); });
+				if (tasks.empty())
+					return;//Only reached when stopping.
+
+				task = std::move(tasks.front());
+				tasks.pop();
+				runningTasks++;
+			}
+
+			task();
+
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				runningTasks--;
+				if (tasks.empty() && runningTasks == 0)
+					allTasksDone.notify_all();
+			}
+		}
+	}
+
+public:
+
+	/// <summary>
+	/// Starts threadCount worker threads.  0 uses one thread per hardware thread.
+	/// </summary>
+	explicit ThreadPool(int threadCount = 0) {
+		if (threadCount < 1)
+			threadCount = DefaultThreadCount();
+
+		for (int i = 0; i < threadCount; i++) {
+			workers.emplace_back(&ThreadPool::WorkerLoop, this);
+		}
+	}
+
+	/// <summary>
+	/// Finishes every queued task, then joins the worker threads.
+	/// </summary>
+	~ThreadPool() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+
+		taskAvailable.notify_all();
+		for (std::thread& worker : workers) {
+			worker.join();
+		}
+	}
+
+	static int DefaultThreadCount() {
+		unsigned int hardwareThreads = std::thread::hardware_concurrency();
+		return hardwareThreads > 0 ? static_cast<int>(hardwareThreads) : 1;
+	}
+
+	int ThreadCount() const {
+		return static_cast<int>(workers.size());
+	}
+
+	void Enqueue(std::function<void()> task) {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			tasks.push(std::move(task));
+		}
+
+		taskAvailable.notify_one();
+	}
+
+	/// <summary>
+	/// Blocks until the queue is empty and no task is running.
+	/// </summary>
+	void Wait() {
+		std::unique_lock<std::mutex> lock(mutex);
+		allTasksDone.wait(lock, [this] { return tasks.empty() && runningTasks == 0; });
+	}
+};
\ No newline at end of file
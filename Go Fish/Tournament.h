@@ -0,0 +1,306 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <atomic>
+#include <mutex>
+#include <algorithm>
+#include "ConstantsAndGlobals.h"
+#include "GameState.h"
+#include "NPCFactory.h"
+#include "Simulation.h"
+#include "ThreadPool.h"
+#include "Tracer.h"
+
+#pragma region Tournament
+
+const int TOURNAMENT_BATCH_SIZE = 16;//Games in a row played with the same lineup, so NPCs aren't recreated every game.
+const long long TOURNAMENT_FIRST_ROUND = 1000;//Games played before the first check for a result.
+const double TOURNAMENT_CONFIDENCE_Z = 1.96;//Reported confidence intervals are 95%.
+
+/// <summary>
+/// A matchup stops early once the difference between the strategies is more than this many standard errors from 0.
+/// The results are looked at once per round and rounds double the games played, so there are only a handful of looks.
+///		3.29 (99.9% on a single look) keeps the chance of stopping on a difference that isn't there small across all of them.
+/// </summary>
+const double TOURNAMENT_STOP_Z = 3.29;
+
+/// <summary>
+/// Results of one matchup: strategies[0] against strategies[1] at a fixed number of players.
+/// Index 0 and 1 of the arrays are the two strategies.
+/// </summary>
+struct MatchupResults {
+	long long games = 0;
+	long long turns = 0;
+	long long draws = 0;
+	long long seats[2] = {};//Seats each strategy played, summed over games.
+	long long wins[2] = {};//Outright wins by each strategy's seats.
+	long long fourOfAKinds[2] = {};
+	long long scoreSum = 0;//Sum over games of 60 * (strategy 0's wins per seat - strategy 1's wins per seat).
+	long long scoreSquares = 0;//Sum of the squares of the same per game scores.
+
+	/// <summary>
+	/// Adds the results from another thread into these results.  Everything is an integer so the totals don't depend on the
+	///		order threads finish in, and neither does when a matchup stops.
+	/// </summary>
+	void Merge(const MatchupResults& other) {
+		games += other.games;
+		turns += other.turns;
+		draws += other.draws;
+		for (int i = 0; i < 2; i++) {
+			seats[i] += other.seats[i];
+			wins[i] += other.wins[i];
+			fourOfAKinds[i] += other.fourOfAKinds[i];
+		}
+
+		scoreSum += other.scoreSum;
+		scoreSquares += other.scoreSquares;
+	}
+
+	/// <summary>
+	/// Average over games of strategy 0's wins per seat minus strategy 1's.
+	/// </summary>
+	double Difference() const {
+		return games > 0 ? scoreSum / (60.0 * games) : 0;
+	}
+
+	double DifferenceStandardError() const {
+		if (games < 2)
+			return 0;
+
+		double mean = static_cast<double>(scoreSum) / games;
+		double variance = (scoreSquares - mean * scoreSum) / (games - 1);
+
+		return std::sqrt(std::max(variance, 0.0) / games) / 60.0;
+	}
+
+	bool Separated() const {
+		double standardError = DifferenceStandardError();
+		return games >= 2 && std::abs(Difference()) > TOURNAMENT_STOP_Z * std::max(standardError, 1e-12);
+	}
+};
+
+/// <summary>
+/// Gets the Wilson score interval for successes out of trials.
+/// </summary>
+void WilsonInterval(long long successes, long long trials, double z, double& low, double& high) {
+	if (trials == 0) {
+		low = 0;
+		high = 1;
+		return;
+	}
+
+	double p = static_cast<double>(successes) / trials;
+	double z2 = z * z;
+	double center = (p + z2 / (2 * trials)) / (1 + z2 / trials);
+	double halfWidth = z * std::sqrt(p * (1 - p) / trials + z2 / (4.0 * trials * trials)) / (1 + z2 / trials);
+	low = center - halfWidth;
+	high = center + halfWidth;
+}
+
+/// <summary>
+/// Plays one game of a matchup.  Seat i is played by strategy 0 if bit i of lineup is set, otherwise by strategy 1.
+/// </summary>
+template<typename GameType>
+void PlayTournamentGame(GameType& game, uint64_t gameSeed, int lineup, MatchupResults& results) {
+	game.StartGame(gameSeed);
+	long long turns = 0;
+	while (!game.GameOver()) {
+		TRACE_SCOPE(Turn, game.currentPlayer->value.playerNumber);
+		Guess guess = game.GetNPCGuess();
+		game.PlayGuess(guess);
+		turns++;
+	}
+
+	std::vector<int> winners = game.TallyScores();
+	int seats[2] = {};
+	int wins[2] = {};
+	for (int i = 0; i < static_cast<int>(game.Scores.size()); i++) {
+		int strategy = lineup >> i & 1 ? 0 : 1;
+		seats[strategy]++;
+		results.fourOfAKinds[strategy] += game.Scores[i];
+		if (winners.size() == 1 && winners[0] == i)
+			wins[strategy]++;
+	}
+
+	//Seats per strategy are 1 to MAX_PLAYERS - 1, which all divide 60, so the score is a whole number.
+	long long score = 60 * wins[0] / seats[0] - 60 * wins[1] / seats[1];
+	results.games++;
+	results.turns += turns;
+	results.draws += winners.size() == 1 ? 0 : 1;
+	for (int i = 0; i < 2; i++) {
+		results.seats[i] += seats[i];
+		results.wins[i] += wins[i];
+	}
+
+	results.scoreSum += score;
+	results.scoreSquares += score * score;
+}
+
+/// <summary>
+/// Plays strategies[0] against strategies[1] with numberOfPlayers players until the difference between them is separated
+///		from 0 or options.games games have been played.
+/// Every way of splitting the seats between the two strategies (each with at least one seat) is its own lineup, and the
+///		lineups take turns in batches of TOURNAMENT_BATCH_SIZE games.  Rounds always end on a whole cycle of lineups, so
+///		seat order and the number of seats each strategy has cancel out of the results.
+/// Game seeds only depend on options.seed, matchupNumber and the game number, so the results are the same for any number of threads.
+/// </summary>
+template<typename GameType>
+MatchupResults PlayMatchup(const SimulationOptions& options, ThreadPool& pool, const std::string(&strategies)[2], int numberOfPlayers,
+	uint64_t matchupNumber, bool& stoppedEarly) {
+	const int lineups = (1 << numberOfPlayers) - 2;//Bitmasks 1 to 2^n - 2.  0 and all bits set would only have one strategy.
+	const long long cycleGames = static_cast<long long>(lineups) * TOURNAMENT_BATCH_SIZE;
+	const long long maxCycles = std::max(1LL, options.games / cycleGames);
+	uint64_t matchupSeed = Random::StreamSeed(options.seed, matchupNumber);
+
+	MatchupResults results;
+	std::mutex resultsMutex;
+	long long cycles = 0;
+	long long roundCycles = std::min(maxCycles, (TOURNAMENT_FIRST_ROUND + cycleGames - 1) / cycleGames);
+	stoppedEarly = false;
+	while (true) {
+		std::atomic<long long> nextBatch(cycles * lineups);
+		long long endBatch = (cycles + roundCycles) * lineups;
+		for (int i = 0; i < pool.ThreadCount(); i++) {
+			pool.Enqueue([&] {
+				GameType game;
+				game.PopulatePlayers(numberOfPlayers, HeadlessPlayerName(0));
+				int currentLineup = 0;
+				MatchupResults threadResults;
+				long long batch;
+				while ((batch = nextBatch.fetch_add(1)) < endBatch) {
+					int lineup = static_cast<int>(batch % lineups) + 1;
+					for (int seat = 0; seat < numberOfPlayers; seat++) {
+						int strategy = lineup >> seat & 1 ? 0 : 1;
+						if (currentLineup == 0 || (currentLineup >> seat & 1) != (lineup >> seat & 1))
+							SetStrategy(game, seat, strategies[strategy], options.ismcts);
+					}
+
+					currentLineup = lineup;
+					TRACE_SCOPE(Batch, batch * TOURNAMENT_BATCH_SIZE);
+					long long firstGame = batch * TOURNAMENT_BATCH_SIZE;
+					for (long long gameNumber = firstGame; gameNumber < firstGame + TOURNAMENT_BATCH_SIZE; gameNumber++) {
+						TRACE_SCOPE(Game, gameNumber);
+						PlayTournamentGame(game, GameSeed(matchupSeed, gameNumber), lineup, threadResults);
+					}
+				}
+
+				std::lock_guard<std::mutex> lock(resultsMutex);
+				results.Merge(threadResults);
+			});
+		}
+
+		pool.Wait();
+		cycles += roundCycles;
+		if (cycles >= maxCycles)
+			break;
+
+		if (results.Separated()) {
+			stoppedEarly = true;
+			break;
+		}
+
+		roundCycles = std::min(cycles, maxCycles - cycles);
+	}
+
+	return results;
+}
+
+/// <summary>
+/// Prints one matchup's results on one line.
+/// </summary>
+void PrintMatchup(const std::string(&strategies)[2], int numberOfPlayers, const MatchupResults& results, bool stoppedEarly) {
+	double games = static_cast<double>(results.games);
+	std::cout << numberOfPlayers << " players, " << strategies[0] << " vs " << strategies[1] << ": " << results.games << " games"
+		<< (stoppedEarly ? " (stopped early)" : "") << ", " << results.turns / games << " turns per game, " << 100.0 * results.draws / games << "% draws\n";
+	for (int i = 0; i < 2; i++) {
+		double low, high;
+		WilsonInterval(results.wins[i], results.seats[i], TOURNAMENT_CONFIDENCE_Z, low, high);
+		std::cout << "    " << strategies[i] << ": " << 100.0 * results.wins[i] / results.seats[i] << "% wins per seat (95% CI "
+			<< 100 * low << "% - " << 100 * high << "%), " << static_cast<double>(results.fourOfAKinds[i]) / results.seats[i] << " four of a kinds per seat\n";
+	}
+
+	double difference = results.Difference();
+	double margin = TOURNAMENT_CONFIDENCE_Z * results.DifferenceStandardError();
+	std::cout << "    Difference: " << 100 * difference << "% +/- " << 100 * margin << "% -> "
+		<< (results.Separated() ? strategies[difference > 0 ? 0 : 1] + " is stronger" : std::string("not separated")) << "\n";
+}
+
+/// <summary>
+/// Plays every pair of strategies against each other at every player count and prints each matchup as it finishes, then
+///		a table of matchups won, lost and not separated by each strategy.
+/// Strategies are options.strategies, or every strategy in NPC_STRATEGIES if none were given.  Player counts are
+///		MIN_PLAYERS to MAX_PLAYERS unless --players was given.  options.games is the most games played in each matchup.
+/// </summary>
+template<typename GameType>
+void RunTournamentGames(const SimulationOptions& options) {
+	std::vector<std::string> strategies;
+	const std::vector<std::string>& requested = options.strategies.empty() ? std::vector<std::string>(std::begin(NPC_STRATEGIES), std::end(NPC_STRATEGIES)) : options.strategies;
+	for (const std::string& strategy : requested) {
+		if (std::find(strategies.begin(), strategies.end(), strategy) == strategies.end())
+			strategies.push_back(strategy);
+	}
+
+	if (strategies.size() < 2) {
+		std::cout << "A tournament needs at least 2 different strategies.\n";
+		return;
+	}
+
+	int minPlayers = options.fixedPlayerCount ? options.numberOfPlayers : MIN_PLAYERS;
+	int maxPlayers = options.fixedPlayerCount ? options.numberOfPlayers : MAX_PLAYERS;
+	ThreadPool pool(options.threads);
+	std::cout << "Tournament: " << strategies.size() << " strategies, " << minPlayers << " - " << maxPlayers << " players, up to "
+		<< options.games << " games per matchup, Threads: " << pool.ThreadCount() << ", Seed: " << options.seed << "\n\n";
+
+	//record[strategy][0] is matchups won, [1] lost and [2] not separated.
+	std::vector<std::array<int, 3>> record(strategies.size(), { 0, 0, 0 });
+	auto start = std::chrono::steady_clock::now();
+	long long totalGames = 0;
+	uint64_t matchupNumber = 0;
+	for (int numberOfPlayers = minPlayers; numberOfPlayers <= maxPlayers; numberOfPlayers++) {
+		for (int first = 0; first < static_cast<int>(strategies.size()); first++) {
+			for (int second = first + 1; second < static_cast<int>(strategies.size()); second++) {
+				const std::string matchup[2] = { strategies[first], strategies[second] };
+				bool stoppedEarly;
+				MatchupResults results = PlayMatchup<GameType>(options, pool, matchup, numberOfPlayers, matchupNumber++, stoppedEarly);
+				PrintMatchup(matchup, numberOfPlayers, results, stoppedEarly);
+				totalGames += results.games;
+				if (!results.Separated()) {
+					record[first][2]++;
+					record[second][2]++;
+				}
+				else {
+					bool firstStronger = results.Difference() > 0;
+					record[first][firstStronger ? 0 : 1]++;
+					record[second][firstStronger ? 1 : 0]++;
+				}
+			}
+		}
+	}
+
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	std::cout << "\nMatchups won / lost / not separated:\n";
+	for (int i = 0; i < static_cast<int>(strategies.size()); i++) {
+		std::cout << "    " << strategies[i] << ": " << record[i][0] << " / " << record[i][1] << " / " << record[i][2] << "\n";
+	}
+
+	std::cout << "Time: " << seconds << "s (" << totalGames << " games, " << (seconds > 0 ? totalGames / seconds : 0) << " games/s)\n";
+}
+
+/// <summary>
+/// Runs the tournament with the hand type chosen by options.
+/// </summary>
+void RunTournament(const SimulationOptions& options) {
+	if (options.bitboardHands) {
+		RunTournamentGames<BitboardGameState>(options);
+	}
+	else {
+		RunTournamentGames<GameState>(options);
+	}
+}
+
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <atomic>
+#include <mutex>
+#include <cstdio>
+#include <cstdint>
+
+#pragma region Tracer
+
+/// <summary>
+/// What a trace event covers.  TRACE_EVENT_NAMES has the name shown in the trace viewer for each.
+/// </summary>
+enum class TraceEventType : uint8_t {
+	Batch,//A batch of games taken from the shared counter by a simulation worker.  The argument is the first game number.
+	Game,//The argument is the game number.
+	Turn,//One guess.  The argument is the guessing player's number.
+	NPCDecision,//GetNPCGuess.  The argument is the guessing player's number.
+	ResolveGuess,//UpdateGuessResult.  The argument is the guessing player's number.
+	Count
+};
+
+static const char* const TRACE_EVENT_NAMES[] = { "Batch", "Game", "Turn", "NPC decision", "Resolve guess" };
+static const char* const TRACE_EVENT_ARGUMENTS[] = { "firstGame", "game", "player", "player", "player" };
+
+/// <summary>
+/// One finished scope.  Times are nanoseconds since the tracer started.
+/// </summary>
+struct TraceEvent {
+	uint64_t start;
+	uint64_t duration;
+	TraceEventType type;
+	int64_t argument;
+};
+
+/// <summary>
+/// Holds the most recent events recorded by one thread.  Only the owning thread writes, so recording takes no lock: the event is
+///		written, then head is published with a release store.  When the buffer is full the oldest events are overwritten.
+/// </summary>
+class TraceRingBuffer {
+	std::unique_ptr<TraceEvent[]> events;
+	uint64_t mask;
+	std::atomic<uint64_t> head;//Total events ever recorded.
+
+public:
+	TraceRingBuffer(uint64_t Capacity, int ThreadID, const std::string& ThreadName) : events(new TraceEvent[Capacity]), mask(Capacity - 1), head(0),
+		threadID(ThreadID), threadName(ThreadName) {}
+
+	int threadID;
+	std::string threadName;
+
+	void Record(const TraceEvent& event) {
+		uint64_t index = head.load(std::memory_order_relaxed);
+		events[index & mask] = event;
+		head.store(index + 1, std::memory_order_release);
+	}
+
+	uint64_t Recorded() const {
+		return head.load(std::memory_order_acquire);
+	}
+
+	uint64_t Dropped() const {
+		uint64_t recorded = Recorded();
+		return recorded > mask + 1 ? recorded - (mask + 1) : 0;
+	}
+
+	/// <summary>
+	/// Calls func on every event still in the buffer, oldest first.  Only call after the owning thread has stopped recording.
+	/// </summary>
+	template<typename Func>
+	void ForEach(Func func) const {
+		uint64_t recorded = Recorded();
+		for (uint64_t i = Dropped(); i < recorded; i++) {
+			func(events[i & mask]);
+		}
+	}
+};
+
+/// <summary>
+/// Is set once by Tracer::Start before any worker threads are created, and only read after that, so the hot paths check it
+///		with a plain load.
+/// </summary>
+inline bool tracingEnabled = false;
+
+/// <summary>
+/// Tracer gives each thread its own TraceRingBuffer the first time it records, and writes every buffer as Chrome trace event
+///		JSON, which chrome://tracing and ui.perfetto.dev open.  Each scope is one complete ("X") event, and each thread is its own track.
+/// </summary>
+class Tracer {
+	Tracer() : capacity(0) {}
+
+	std::mutex mutex;//Only taken when a thread gets its buffer and when writing.
+	std::vector<std::unique_ptr<TraceRingBuffer>> buffers;
+	uint64_t capacity;
+	std::chrono::steady_clock::time_point epoch;
+
+public:
+	static Tracer& Get() {
+		static Tracer instance;
+		return instance;
+	}
+
+	/// <summary>
+	/// Turns tracing on.  Each thread keeps its most recent eventsPerThread events, rounded up to a power of 2.
+	/// </summary>
+	void Start(uint64_t eventsPerThread) {
+		capacity = 1;
+		while (capacity < eventsPerThread) {
+			capacity <<= 1;
+		}
+
+		epoch = std::chrono::steady_clock::now();
+		tracingEnabled = true;
+	}
+
+	uint64_t Now() const {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+	}
+
+	/// <summary>
+	/// Gets the calling thread's buffer, creating it the first time.  The buffers belong to the Tracer, so events from
+	///		threads that have exited are still written.
+	/// </summary>
+	TraceRingBuffer& ThreadBuffer() {
+		thread_local TraceRingBuffer* buffer = nullptr;
+		if (buffer == nullptr) {
+			std::lock_guard<std::mutex> lock(mutex);
+			int threadID = static_cast<int>(buffers.size());
+			buffers.push_back(std::make_unique<TraceRingBuffer>(capacity, threadID, "Thread " + std::to_string(threadID)));
+			buffer = buffers.back().get();
+		}
+
+		return *buffer;
+	}
+
+	/// <summary>
+	/// Writes every thread's events to path.  Call once the threads being traced have finished.
+	/// </summary>
+	/// <returns>False if the file couldn't be written.</returns>
+	bool WriteJson(const std::string& path) {
+		std::lock_guard<std::mutex> lock(mutex);
+		std::ofstream file(path);
+		if (!file)
+			return false;
+
+		uint64_t events = 0;
+		uint64_t dropped = 0;
+		char line[256];
+		file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+		file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Go Fish\"}}";
+		for (const std::unique_ptr<TraceRingBuffer>& buffer : buffers) {
+			file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadID << ",\"args\":{\"name\":\"" << buffer->threadName << "\"}}";
+			buffer->ForEach([&](const TraceEvent& event) {
+				int type = static_cast<int>(event.type);
+				//Trace event times are microseconds.  Keeping 3 decimals keeps the nanoseconds.
+				std::snprintf(line, sizeof(line), ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%llu.%03llu,\"dur\":%llu.%03llu,\"args\":{\"%s\":%lld}}",
+					TRACE_EVENT_NAMES[type], buffer->threadID, static_cast<unsigned long long>(event.start / 1000), static_cast<unsigned long long>(event.start % 1000),
+					static_cast<unsigned long long>(event.duration / 1000), static_cast<unsigned long long>(event.duration % 1000), TRACE_EVENT_ARGUMENTS[type], static_cast<long long>(event.argument));
+				file << line;
+				events++;
+			});
+
+			dropped += buffer->Dropped();
+		}
+
+		file << "\n],\"otherData\":{\"threads\":" << buffers.size() << ",\"events\":" << events << ",\"droppedEvents\":" << dropped << "}}\n";
+		std::cout << "Trace: " << events << " events from " << buffers.size() << " threads written to " << path;
+		if (dropped > 0)
+			std::cout << " (" << dropped << " older events were overwritten.  Use --trace-buffer to keep more)";
+
+		std::cout << "\n";
+
+		return file.good();
+	}
+};
+
+/// <summary>
+/// Records the time from construction to the end of the scope as one event when tracing is on.  Does nothing otherwise.
+/// </summary>
+class TraceScope {
+	uint64_t start;
+	int64_t argument;
+	TraceEventType type;
+	bool recording;
+
+public:
+	TraceScope(TraceEventType Type, int64_t Argument) : start(0), argument(Argument), type(Type), recording(tracingEnabled) {
+		if (recording)
+			start = Tracer::Get().Now();
+	}
+
+	~TraceScope() {
+		if (!recording)
+			return;
+
+		Tracer& tracer = Tracer::Get();
+		tracer.ThreadBuffer().Record({ start, tracer.Now() - start, type, argument });
+	}
+
+	TraceScope(const TraceScope& other) = delete;
+};
+
+#pragma endregion
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(type, argument) TraceScope TRACE_CONCAT(traceScope, __LINE__)(TraceEventType::type, argument)
\ No newline at end of file
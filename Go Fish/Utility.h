@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstddef>
+
+/// <summary>
+/// Gets the number of elements in a fixed size array.
+/// </summary>
+template<typename T, size_t N>
+constexpr int SizeOfArray(const T(&)[N]) {
+	return static_cast<int>(N);
+}
\ No newline at end of file
@@ -2,6 +2,15 @@
 
 #include <iostream>
 #include <string>
+#include <stack>
+#include <stdexcept>
+#include <vector>
+#include <iterator>
+#include <cstddef>
+#include "Random.h"
+#include "Shuffle.h"
+#include "NodePool.h"
+#include "Instrumentation.h"
 
 template<typename T>
 class linkedList;
@@ -20,9 +29,13 @@ struct element {
 	linkedList<T>* list;
 
 	template<typename... Args>
-	element(linkedList<T>* List, Args&&... args) : list(List), value(std::forward<Args>(args)...) {}
+	element(linkedList<T>* List, Args&&... args) : value(std::forward<Args>(args)...), list(List) {}
 
 	~element() {
+		//The end element has nothing after it to bridge to and isn't counted.
+		if (IsEnd())
+			return;
+
 		BridgeAcross();
 		list->count--;
 	}
@@ -60,13 +73,13 @@ struct element {
 		return !IsEnd() && nextElement->IsEnd();
 	}
 
-	template<typename T>
 	static void Inc(element<T>*& el) {
+		INSTRUMENT_TRAVERSAL();
 		el = el->nextElement;
 	}
 
-	template<typename T>
 	static void Dec(element<T>*& el) {
+		INSTRUMENT_TRAVERSAL();
 		el = el->previousElement;
 	}
 
@@ -78,7 +91,7 @@ struct element {
 	/// Inserts value just before this element in the list
 	/// </summary>
 	void InsertNewBeforeMe(const T& value) {
-		element<T>* newElement = new element<T>(list, value);
+		element<T>* newElement = list->CreateElement(value);
 		newElement->InsertMeBeforeOther(this);
 	}
 
@@ -87,7 +100,7 @@ struct element {
 	/// </summary>
 	template<typename... Args>
 	void EmplaceNewBeforeMe(Args&&... args) {
-		element<T>* newElement = new element<T>(list, args...);
+		element<T>* newElement = list->CreateElement(args...);
 		newElement->InsertMeBeforeOther(this);
 	}
 
@@ -95,7 +108,7 @@ struct element {
 	/// Inserts value just after this element in the list
 	/// </summary>
 	void InsertNewAfterMe(const T& value) {
-		element<T>* newElement = new element<T>(list, value);
+		element<T>* newElement = list->CreateElement(value);
 		newElement->InsertMeAfterOther(this);
 	}
 
@@ -104,12 +117,12 @@ struct element {
 	/// </summary>
 	template<typename... Args>
 	void EmplaceNewAfterMe(Args&&... args) {
-		element<T>* newElement = new element<T>(list, args...);
+		element<T>* newElement = list->CreateElement(args...);
 		newElement->InsertMeAfterOther(this);
 	}
 
 	void Remove() {
-		delete this;
+		list->DestroyElement(this);
 	}
 
 	void MoveMeBeforeOther(element<T>* other) {
@@ -130,6 +143,8 @@ struct element {
 		if (&other == this)
 			return;
 
+		list->InvalidateIndex();
+
 		if (IsFirst()) {
 			list->firstElement = &other;
 		}
@@ -170,6 +185,7 @@ struct element {
 	/// Used when inserting or moving an element.
 	/// </summary>
 	void InsertMeBeforeOther(element<T>* other) {
+		list->InvalidateIndex();
 		if (other->IsFirst()) {
 			//other is the first element
 
@@ -199,6 +215,7 @@ struct element {
 	/// Used when inserting or moving an element.
 	/// </summary>
 	void InsertMeAfterOther(element<T>* other) {
+		list->InvalidateIndex();
 		if (other->IsEnd()) {
 			//Other is the end element, not allowed to move the end element, so insert before it instead.
 			InsertMeBeforeOther(other);
@@ -221,6 +238,7 @@ struct element {
 	/// Used when removing or moving an element.
 	/// </summary>
 	void BridgeAcross() {
+		list->InvalidateIndex();
 		if (IsFirst()) {
 			//This element is the first element
 
@@ -286,7 +304,7 @@ private:
 
 	/// <summary>
 	/// End element is a dummy element to help with knowing where the end is and inserting new elements.<br/>
-	/// It should always be the end element.
+	/// It should always be the end element.  It lives in endSentinel, so every list has its own without allocating one.
 	/// </summary>
 	element<T>* endElement;
 
@@ -302,27 +320,122 @@ private:
 	bool sorted = false;
 
 	typedef std::string(*ToStringFunc)(const T&);
-	static std::string ElementToStringFuncDefault(const T& value) { return ""; }
+	static std::string ElementToStringFuncDefault(const T& /*value*/) { return ""; }
 	ToStringFunc elementToStringFunc;
 
 	/// <summary>
-	/// Creates the 
+	/// If not nullptr, elements are created from pool instead of the global allocator.  The end element never comes from the pool either way.
+	/// </summary>
+	NodePool<element<T>>* pool = nullptr;
+
+	/// <summary>
+	/// If indexed is true, operator[] looks elements up in elementIndex instead of walking the list.
+	/// elementIndex is only rebuilt the first time operator[] is used after the list changes, so lists that are read much more
+	///		than they are changed (like the players) get O(1) access, and changing the list only costs setting indexValid to false.
+	/// </summary>
+	bool indexed = false;
+	bool indexValid = false;
+	std::vector<element<T>*> elementIndex;
+
+	/// <summary>
+	/// The end element.  Part of the list itself, so making, moving and destroying a list never allocates or frees it.
+	/// </summary>
+	element<T> endSentinel{ this };
+
+	void InvalidateIndex() {
+		indexValid = false;
+	}
+
+	void RebuildIndex() {
+		elementIndex.clear();
+		elementIndex.reserve(count);
+		for (element<T>* current = firstElement; !current->IsEnd(); element<T>::Inc(current)) {
+			elementIndex.push_back(current);
+		}
+
+		indexValid = true;
+	}
+
+	/// <summary>
+	/// Makes the list empty, with only its end element.
 	/// </summary>
 	void Setup() {
-		endElement = new element<T>(this);
+		endElement = &endSentinel;
 		firstElement = endElement;
 	}
 
-	linkedList(const linkedList& other) = delete;
+	/// <summary>
+	/// Creates a new element that isn't linked to anything yet, using the pool if there is one.
+	/// </summary>
+	template<typename... Args>
+	element<T>* CreateElement(Args&&... args) {
+		INSTRUMENT_ALLOCATION();
+		if (pool != nullptr)
+			return new (pool->Allocate()) element<T>(this, std::forward<Args>(args)...);
 
-	//linkedList(const linkedList& other) {
-	//	//Fatal design flaw, each element tracks the list, so you need to update the list pointer for each element.
-	//	element<T>* current = First();
-	//	while (current != nullptr) {
-	//		current->list = this;
-	//		element<T>::Inc(current);
-	//	}
-	//}
+		AllocationCounters::Current().elementNews++;
+		return new element<T>(this, std::forward<Args>(args)...);
+	}
+
+	/// <summary>
+	/// Unlinks and destroys the element, giving its memory back to wherever CreateElement got it from.
+	/// </summary>
+	void DestroyElement(element<T>* current) {
+		INSTRUMENT_ALLOCATION();
+		if (pool != nullptr) {
+			current->~element();
+			pool->Free(current);
+		}
+		else {
+			AllocationCounters::Current().elementDeletes++;
+			delete current;
+		}
+	}
+
+	/// <summary>
+	/// Adds a new element with a copy of each of other's values to the end of this list, keeping their order.
+	/// </summary>
+	void AppendCopies(const linkedList& other) {
+		for (element<T>* current = other.firstElement; !current->IsEnd(); element<T>::Inc(current)) {
+			CreateElement(current->value)->InsertMeBeforeOther(endElement);
+		}
+
+		count += other.count;
+	}
+
+	/// <summary>
+	/// Points every element, including the end element, back at this list.
+	/// Each element tracks its list, so this has to be done whenever elements change which list object owns them.
+	/// </summary>
+	void AdoptAll() {
+		for (element<T>* current = firstElement; current != nullptr; element<T>::Inc(current)) {
+			current->list = this;
+		}
+	}
+
+	/// <summary>
+	/// Moves other's elements onto this list's end element and swaps every setting with other.  This list must be empty.
+	/// Each list keeps its own end element, so other is left as a valid empty list without allocating anything.
+	/// </summary>
+	void TakeContents(linkedList& other) noexcept {
+		if (other.count > 0) {
+			firstElement = other.firstElement;
+			endElement->previousElement = other.endElement->previousElement;
+			endElement->previousElement->nextElement = endElement;
+			other.firstElement = other.endElement;
+			other.endElement->previousElement = nullptr;
+		}
+
+		std::swap(count, other.count);
+		std::swap(sorted, other.sorted);
+		std::swap(elementToStringFunc, other.elementToStringFunc);
+		std::swap(pool, other.pool);
+		std::swap(indexed, other.indexed);
+		std::swap(elementIndex, other.elementIndex);
+		indexValid = false;
+		other.indexValid = false;
+		AdoptAll();
+	}
 
 	friend struct element<T>;
 
@@ -336,14 +449,14 @@ public:
 	/// Initialize the list with no values except the end element.
 	/// </summary>
 	/// <param name="sort"></param>
-	linkedList(ToStringFunc ElementToStringFunc = ElementToStringFuncDefault, bool sort = false) : elementToStringFunc(ElementToStringFunc), sorted(sort) {
+	linkedList(ToStringFunc ElementToStringFunc = ElementToStringFuncDefault, bool sort = false) : sorted(sort), elementToStringFunc(ElementToStringFunc) {
 		Setup();
 	}
 
 	/// <summary>
 	/// Initialize the list with value as the first value.
 	/// </summary>
-	linkedList(const T& value, ToStringFunc ElementToStringFunc = ElementToStringFuncDefault, bool sort = false) : elementToStringFunc(ElementToStringFunc), sorted(sort) {
+	linkedList(const T& value, ToStringFunc ElementToStringFunc = ElementToStringFuncDefault, bool sort = false) : sorted(sort), elementToStringFunc(ElementToStringFunc) {
 		Setup();
 		Add(value);
 	}
@@ -352,15 +465,159 @@ public:
 	/// Initialize the list, then add all values from the array to the list.
 	/// </summary>
 	template<size_t S>
-	linkedList(const T(&arr)[S], ToStringFunc ElementToStringFunc = ElementToStringFuncDefault, bool sort = false) : elementToStringFunc(ElementToStringFunc), sorted(sort) {
+	linkedList(const T(&arr)[S], ToStringFunc ElementToStringFunc = ElementToStringFuncDefault, bool sort = false) : sorted(sort), elementToStringFunc(ElementToStringFunc) {
 		Setup();
 		Add(arr);
 	}
 
+	/// <summary>
+	/// Deep copy.  Creates a new element for each of other's values, so the copy and other never share elements.
+	/// The copy uses the same pool as other.
+	/// </summary>
+	linkedList(const linkedList& other) : sorted(other.sorted), elementToStringFunc(other.elementToStringFunc), pool(other.pool), indexed(other.indexed) {
+		Setup();
+		AppendCopies(other);
+	}
+
+	/// <summary>
+	/// Move constructor.  Takes other's elements without copying them, and doesn't allocate or throw, so containers of
+	///		linkedLists move them when they grow instead of copying.
+	/// other is left as a valid empty list, so it can still be used or destroyed.
+	/// </summary>
+	linkedList(linkedList&& other) noexcept : elementToStringFunc(other.elementToStringFunc) {
+		Setup();
+		TakeContents(other);
+	}
+
+	/// <summary>
+	/// Deletes every element.  The end element goes with the list.
+	/// If the list uses a pool, the pool must still exist.
+	/// </summary>
+	~linkedList() {
+		Clear();
+	}
+
 	friend struct element<T>;
 
 #pragma endregion
 
+#pragma region Iterators
+
+	/// <summary>
+	/// Bidirectional iterator over the values in the list so range-for, std algorithms and std::ranges work on linkedLists.
+	/// Wraps an element, so it stays valid as long as that element is in the list.  end() wraps the end element.
+	/// </summary>
+	template<bool Const>
+	class Iterator {
+	public:
+		typedef std::bidirectional_iterator_tag iterator_category;
+		typedef T value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef std::conditional_t<Const, const T*, T*> pointer;
+		typedef std::conditional_t<Const, const T&, T&> reference;
+
+		Iterator() : current(nullptr) {}
+		explicit Iterator(element<T>* Current) : current(Current) {}
+
+		/// <summary>
+		/// Allows an iterator to be used where a const_iterator is expected.
+		/// </summary>
+		template<bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+		Iterator(const Iterator<OtherConst>& other) : current(other.Element()) {}
+
+		/// <summary>
+		/// Gets the element the iterator is at.
+		/// </summary>
+		element<T>* Element() const {
+			return current;
+		}
+
+		reference operator*() const {
+			return current->value;
+		}
+
+		pointer operator->() const {
+			return &current->value;
+		}
+
+		Iterator& operator++() {
+			element<T>::Inc(current);
+			return *this;
+		}
+
+		Iterator operator++(int) {
+			Iterator copy = *this;
+			element<T>::Inc(current);
+			return copy;
+		}
+
+		Iterator& operator--() {
+			element<T>::Dec(current);
+			return *this;
+		}
+
+		Iterator operator--(int) {
+			Iterator copy = *this;
+			element<T>::Dec(current);
+			return copy;
+		}
+
+		bool operator==(const Iterator& other) const {
+			return current == other.current;
+		}
+
+		bool operator!=(const Iterator& other) const {
+			return current != other.current;
+		}
+
+	private:
+		element<T>* current;
+	};
+
+	typedef Iterator<false> iterator;
+	typedef Iterator<true> const_iterator;
+	typedef T value_type;
+
+	iterator begin() {
+		return iterator(firstElement);
+	}
+
+	iterator end() {
+		return iterator(endElement);
+	}
+
+	const_iterator begin() const {
+		return const_iterator(firstElement);
+	}
+
+	const_iterator end() const {
+		return const_iterator(endElement);
+	}
+
+	const_iterator cbegin() const {
+		return begin();
+	}
+
+	const_iterator cend() const {
+		return end();
+	}
+
+	/// <summary>
+	/// Copies the values into a vector in order.  Used to hand large lists to algorithms that need random access,
+	///		like the std::execution::par overloads.
+	/// </summary>
+	std::vector<T> ToVector() const {
+		std::vector<T> values;
+		values.reserve(count);
+		for (const T& value : *this) {
+			values.push_back(value);
+		}
+
+		return values;
+	}
+
+#pragma endregion
+
 #pragma region Getters
 
 	/// <summary>
@@ -388,10 +645,40 @@ public:
 	/// <summary>
 	/// Gets the number of elements in the list, not including the end element.
 	/// </summary>
-	int Count() {
+	int Count() const {
 		return count;
 	}
 
+	NodePool<element<T>>* Pool() const {
+		return pool;
+	}
+
+	/// <summary>
+	/// Makes the list create its elements from Pool instead of the global allocator.  nullptr goes back to the global allocator.
+	/// Can only be changed while the list is empty because elements must be destroyed the same way they were created.
+	/// </summary>
+	void SetPool(NodePool<element<T>>* Pool) {
+		if (count != 0)
+			throw std::logic_error("The pool can only be changed while the list is empty. count: " + std::to_string(count));
+
+		pool = Pool;
+	}
+
+	bool Indexed() const {
+		return indexed;
+	}
+
+	/// <summary>
+	/// Turns the indexed mode for operator[] on or off.  Elements never move in memory either way, so element pointers stay valid.
+	/// </summary>
+	void SetIndexed(bool Indexed) {
+		indexed = Indexed;
+		indexValid = false;
+		elementIndex.clear();
+		if (!indexed)
+			elementIndex.shrink_to_fit();
+	}
+
 #pragma endregion
 
 #pragma region Adding/Removing
@@ -421,10 +708,54 @@ public:
 		if (end <= start)
 			return;
 
-		//Add each value from [start, end).
-		while (start < end) {
-			Add(arr[start++]);
+		AddBatch(arr + start, end - start);
+	}
+
+	/// <summary>
+	/// Adds valueCount values at once.
+	/// If the list is sorted, the new elements are merge sorted by themselves first, then merged into the list in a single pass,
+	///		so adding k values to a list of n is O(k log k + n) instead of the O(k * n) of adding them one at a time.
+	/// Values equal to ones already in the list go after them, the same as Add.
+	/// </summary>
+	void AddBatch(const T* values, int valueCount) {
+		if (valueCount <= 0)
+			return;
+
+		if (!sorted) {
+			for (int i = 0; i < valueCount; i++) {
+				endElement->InsertNewBeforeMe(values[i]);
+			}
+
+			count += valueCount;
+			return;
+		}
+
+		//Chain the new elements together by nextElement only, then sort the chain.
+		element<T>* head = nullptr;
+		element<T>** tail = &head;
+		for (int i = 0; i < valueCount; i++) {
+			*tail = CreateElement(values[i]);
+			tail = &(*tail)->nextElement;
+		}
+
+		head = MergeSortChain(head, valueCount);
+		if (count == 0) {
+			//Nothing to merge with, like dealing an opening hand.
+			RelinkChain(head);
+			count = valueCount;
+			return;
+		}
+
+		//Both are sorted, so each new element only continues searching from where the previous one was inserted.
+		element<T>* insertElement = First();
+		while (head != nullptr) {
+			element<T>* next = head->nextElement;
+			insertElement = FindInsertElement(insertElement, head->value);
+			head->InsertMeBeforeOther(insertElement);
+			head = next;
 		}
+
+		count += valueCount;
 	}
 
 	/// <summary>
@@ -432,7 +763,7 @@ public:
 	/// </summary>
 	template<typename... Args>
 	void Emplace(Args&&... args) {
-		element<T>* newElement = new element<T>(this, args...);
+		element<T>* newElement = CreateElement(args...);
 		if (sorted) {
 			//If the list is already sorted, insert sort the new element.
 			InsertSort(newElement);
@@ -455,6 +786,8 @@ public:
 		else {
 			current->InsertNewAfterMe(value);
 		}
+
+		++count;
 	}
 
 	/// <summary>
@@ -470,8 +803,9 @@ public:
 	/// </summary>
 	template<typename... Args>
 	void EmplaceSort(Args&&... args) {
-		element<T>* newElement = new element<T>(this, args...);
+		element<T>* newElement = CreateElement(args...);
 		InsertSort(newElement);
+		++count;
 	}
 
 	/// <summary>
@@ -508,6 +842,135 @@ public:
 
 #pragma endregion
 
+#pragma region Splicing
+
+	/// <summary>
+	/// Moves the elements [first, last) from source to just before position in this list without creating or deleting any elements.
+	/// Ignores sorted.  Use SpliceSorted to keep a sorted list sorted.
+	/// </summary>
+	/// <param name="last">- The element after the last one to move.  Can be source's end element.</param>
+	/// <returns>The number of elements moved.</returns>
+	int Splice(element<T>* position, linkedList<T>& source, element<T>* first, element<T>* last) {
+		CheckSamePool(source);
+		element<T>* runLast;
+		int moved = source.Detach(first, last, runLast);
+		if (moved == 0)
+			return 0;
+
+		AdoptRun(first, runLast, moved);
+
+		//Link the run in before position.
+		first->previousElement = position->previousElement;
+		runLast->nextElement = position;
+		if (position->IsFirst()) {
+			firstElement = first;
+		}
+		else {
+			position->previousElement->nextElement = first;
+		}
+
+		position->previousElement = runLast;
+
+		return moved;
+	}
+
+	/// <summary>
+	/// Moves a single element from source to just before position in this list.
+	/// </summary>
+	void Splice(element<T>* position, linkedList<T>& source, element<T>* single) {
+		Splice(position, source, single, single->nextElement);
+	}
+
+	/// <summary>
+	/// Moves the elements [first, last) from source into this list without creating or deleting any elements.
+	/// If this list is sorted, the run is merged into place.  The run must be in sorted order, which it always is when it comes from
+	///		a sorted list, so each element only continues searching from where the previous one was inserted.  O(run + insertion point).
+	/// If this list isn't sorted, the run is added to the end.
+	/// </summary>
+	/// <returns>The number of elements moved.</returns>
+	int SpliceSorted(linkedList<T>& source, element<T>* first, element<T>* last) {
+		if (!sorted)
+			return Splice(End(), source, first, last);
+
+		CheckSamePool(source);
+		element<T>* runLast;
+		int moved = source.Detach(first, last, runLast);
+		if (moved == 0)
+			return 0;
+
+		AdoptRun(first, runLast, moved);
+
+		element<T>* insertElement = First();
+		element<T>* current = first;
+		while (current != nullptr) {
+			element<T>* next = current == runLast ? nullptr : current->nextElement;
+			insertElement = FindInsertElement(insertElement, current->value);
+			current->InsertMeBeforeOther(insertElement);
+			current = next;
+		}
+
+		return moved;
+	}
+
+private:
+
+	/// <summary>
+	/// Elements are destroyed by whichever list they end up in, so they can only move between lists that create them the same way.
+	/// </summary>
+	void CheckSamePool(const linkedList<T>& source) const {
+		if (pool != source.pool)
+			throw std::logic_error("Elements can only be spliced between lists that share the same pool.");
+	}
+
+	/// <summary>
+	/// Unlinks [first, last) from this list and removes them from count, but doesn't destroy them.
+	/// The run's own links are left as they were so it can still be walked from first to runLast.
+	/// </summary>
+	/// <returns>The number of elements unlinked.</returns>
+	int Detach(element<T>* first, element<T>* last, element<T>*& runLast) {
+		int detached = 0;
+		runLast = nullptr;
+		for (element<T>* current = first; current != last; element<T>::Inc(current)) {
+			runLast = current;
+			detached++;
+		}
+
+		if (detached == 0)
+			return 0;
+
+		InvalidateIndex();
+		if (first->IsFirst()) {
+			firstElement = last;
+		}
+		else {
+			first->previousElement->nextElement = last;
+		}
+
+		last->previousElement = first->previousElement;
+		count -= detached;
+
+		return detached;
+	}
+
+	/// <summary>
+	/// Points a detached run at this list and adds it to count.
+	/// Both lists must create elements the same way, so elements can later be destroyed by this list.
+	/// </summary>
+	void AdoptRun(element<T>* first, element<T>* runLast, int runCount) {
+		InvalidateIndex();
+		for (element<T>* current = first; ; element<T>::Inc(current)) {
+			current->list = this;
+			if (current == runLast)
+				break;
+		}
+
+		count += runCount;
+	}
+
+public:
+
+#pragma endregion
+
 #pragma region Sorting/Finding
 
 	/// <summary>
@@ -531,7 +994,7 @@ public:
 	/// <param name="goingUp">- true means it will go up the list, false means it will go down the list.</param>
 	/// <returns></returns>
 	element<T>* FindInsertElement(element<T>* start, const T& value, bool after = true) {
-		while (!start->IsEnd() && (after && value >= start->value || !after && value > start->value)) {
+		while (!start->IsEnd() && ((after && value >= start->value) || (!after && value > start->value))) {
 			element<T>::Inc(start);
 		}
 
@@ -545,7 +1008,7 @@ public:
 	/// after being true will continue to pass elements of the same value, putting it after the existing ones.
 	/// after being false will stop at the first element of the same value, putting it before the existing ones.</param>
 	element<T>* FindInsertElementReverse(element<T>* start, const T& value, bool after = true) {
-		while (!start->IsFirst() && (after && value < start->Prev() || !after && value <= start->Prev())) {
+		while (!start->IsFirst() && ((after && value < start->Prev()) || (!after && value <= start->Prev()))) {
 			element<T>::Dec(start);
 		}
 
@@ -554,6 +1017,7 @@ public:
 
 	/// <summary>
 	/// Gets the value by index.  Should only be used when no elements are already available to use to move through the list.
+	/// If the list is indexed, this is O(1) unless the list has changed since the last lookup.  Otherwise, it walks from the closest end.
 	/// </summary>
 	/// <param name="index"></param>
 	/// <returns></returns>
@@ -561,6 +1025,13 @@ public:
 		if (index < 0 || index >= count)
 			throw std::out_of_range("Index out of range. index: " + std::to_string(index) + ", count: " + std::to_string(count));
 
+		if (indexed) {
+			if (!indexValid)
+				RebuildIndex();
+
+			return elementIndex[index];
+		}
+
 		if (index <= count / 2) {
 			element<T>* current = First();
 			while (index-- > 0) {
@@ -588,13 +1059,31 @@ public:
 	}
 
 	/// <summary>
-	/// Sorts the list using insertion sort.
+	/// Sorts the list with a stable merge sort in O(n log n).
+	/// Only the links are changed.  No elements are created, deleted or copied, so pointers to elements stay valid.
 	/// </summary>
 	void Sort() {
 		//Once sorted, it will stay sorted.
 		if (sorted)
 			return;
 
+		sorted = true;
+		if (count < 2)
+			return;
+
+		//Cut the elements off from the end element so they can be sorted as a chain ending in nullptr.
+		Last()->nextElement = nullptr;
+		RelinkChain(MergeSortChain(firstElement, count));
+	}
+
+	/// <summary>
+	/// The original insertion sort.  O(n^2) on unsorted lists.
+	/// Only kept so the benchmark can compare it against Sort.
+	/// </summary>
+	void InsertionSort() {
+		if (sorted)
+			return;
+
 		sorted = true;
 
 		element<T>* current = First();
@@ -610,7 +1099,33 @@ public:
 		}
 	}
 
-	void Shuffle(int passes = 10) {
+	/// <summary>
+	/// Shuffles the list with a Fisher-Yates shuffle in O(n).
+	/// The elements are gathered into contiguous storage, shuffled there, then relinked in their new order.
+	/// No elements are created or deleted, so pointers to elements stay valid.
+	/// </summary>
+	void Shuffle(Random& random) {
+		if (count < 2)
+			return;
+
+		std::vector<element<T>*> elements;
+		elements.reserve(count);
+		for (element<T>* current = First(); !current->IsEnd(); element<T>::Inc(current)) {
+			elements.push_back(current);
+		}
+
+		FisherYatesShuffle(elements.data(), count, random);
+		Relink(elements.data(), count);
+
+		//The values are in a random order now, so adding elements can't insert sort them anymore.
+		sorted = false;
+	}
+
+	/// <summary>
+	/// The original shuffle.  Does passes * count swaps with a random element found with operator[], so it is O(passes * n^2) and biased.
+	/// Only kept so the benchmark can compare it against Shuffle.
+	/// </summary>
+	void SwapShuffle(Random& random, int passes = 10) {
 		if (count < 2)
 			return;
 
@@ -622,8 +1137,7 @@ public:
 				continue;
 			}
 
-			int random = rand() % count;
-			element<T>* randomElement = (*this)[random];
+			element<T>* randomElement = (*this)[random.NextInt(count)];
 			if (current->previousElement == randomElement) {
 				i--;
 				continue;
@@ -633,6 +1147,120 @@ public:
 		}
 	}
 
+	/// <summary>
+	/// Links the elements together in the order they are in elements, then puts the end element after them.
+	/// elements must contain every element in the list except the end element.
+	/// </summary>
+	void Relink(element<T>* const* elements, int elementCount) {
+		InvalidateIndex();
+		if (elementCount == 0) {
+			firstElement = endElement;
+			endElement->previousElement = nullptr;
+			return;
+		}
+
+		firstElement = elements[0];
+		firstElement->previousElement = nullptr;
+		for (int i = 1; i < elementCount; i++) {
+			elements[i - 1]->nextElement = elements[i];
+			elements[i]->previousElement = elements[i - 1];
+		}
+
+		element<T>* last = elements[elementCount - 1];
+		last->nextElement = endElement;
+		endElement->previousElement = last;
+	}
+
+private:
+
+	/// <summary>
+	/// Merge sorts a chain of length elements linked only by nextElement and ending in nullptr.  previousElement is ignored and left stale.
+	/// Short chains are insertion sorted instead because that is faster for the handful of cards in a hand.
+	/// Equal values keep their order.
+	/// </summary>
+	/// <returns>The first element of the sorted chain.</returns>
+	static element<T>* MergeSortChain(element<T>* head, int length) {
+		if (length <= 8)
+			return InsertionSortChain(head);
+
+		//Cut the chain in half.
+		int leftLength = length / 2;
+		element<T>* leftLast = head;
+		for (int i = 1; i < leftLength; i++) {
+			element<T>::Inc(leftLast);
+		}
+
+		element<T>* right = leftLast->nextElement;
+		leftLast->nextElement = nullptr;
+
+		return MergeChains(MergeSortChain(head, leftLength), MergeSortChain(right, length - leftLength));
+	}
+
+	/// <summary>
+	/// Insertion sorts a chain linked only by nextElement and ending in nullptr.  Equal values keep their order.
+	/// </summary>
+	/// <returns>The first element of the sorted chain.</returns>
+	static element<T>* InsertionSortChain(element<T>* head) {
+		element<T>* sorted = nullptr;
+		while (head != nullptr) {
+			element<T>* current = head;
+			head = head->nextElement;
+
+			//Go past every value <= current so equal values stay in the order they were in.
+			element<T>** insert = &sorted;
+			while (*insert != nullptr && !(current->value < (*insert)->value)) {
+				insert = &(*insert)->nextElement;
+			}
+
+			current->nextElement = *insert;
+			*insert = current;
+		}
+
+		return sorted;
+	}
+
+	/// <summary>
+	/// Merges two sorted chains ending in nullptr into one.  When values are equal, left's come first.
+	/// </summary>
+	static element<T>* MergeChains(element<T>* left, element<T>* right) {
+		element<T>* head = nullptr;
+		element<T>** tail = &head;
+		while (left != nullptr && right != nullptr) {
+			if (right->value < left->value) {
+				*tail = right;
+				right = right->nextElement;
+			}
+			else {
+				*tail = left;
+				left = left->nextElement;
+			}
+
+			tail = &(*tail)->nextElement;
+		}
+
+		*tail = left != nullptr ? left : right;
+
+		return head;
+	}
+
+	/// <summary>
+	/// Makes the chain starting at head the whole list.  Fixes every previousElement and puts the end element after the chain.
+	/// </summary>
+	void RelinkChain(element<T>* head) {
+		InvalidateIndex();
+		firstElement = head;
+		head->previousElement = nullptr;
+		element<T>* current = head;
+		for (; current->nextElement != nullptr; element<T>::Inc(current)) {
+			current->nextElement->previousElement = current;
+		}
+
+		current->nextElement = endElement;
+		endElement->previousElement = current;
+	}
+
+public:
+
 	std::stack<T> ToStack() {
 		std::stack<T> stack;
 		if (count > 0) {
@@ -773,25 +1401,36 @@ public:
 		return !(*this < other);
 	}
 
+	/// <summary>
+	/// Deep copy assignment.  Deletes this list's elements, then copies other's values and settings, including its pool.
+	/// </summary>
 	linkedList& operator=(const linkedList& other) {
-		//Fatal design flaw, each element tracks the list, so you need to update the list pointer for each element.
-		element<T>* current = First();
-		while (current != nullptr) {
-			current->list = this;
-			element<T>::Inc(current);
-		}
+		if (this == &other)
+			return *this;
+
+		Clear();
+		sorted = other.sorted;
+		elementToStringFunc = other.elementToStringFunc;
+		pool = other.pool;
+		indexed = other.indexed;
+		InvalidateIndex();
+		AppendCopies(other);
+
+		return *this;
 	}
 
 	/// <summary>
-	/// Move assignment operator.
+	/// Move assignment.  Deletes this list's elements, then takes other's without copying them.
+	/// other is left as a valid empty list with this list's old settings.
 	/// </summary>
-	linkedList(linkedList&& other) noexcept
-		: firstElement(other.firstElement), endElement(other.endElement), count(other.count), sorted(other.sorted), elementToStringFunc(other.elementToStringFunc) {
-		other.firstElement = nullptr;
-		other.endElement = nullptr;
-		other.count = 0;
-		other.sorted = false;
-		other.elementToStringFunc = nullptr;
+	linkedList& operator=(linkedList&& other) noexcept {
+		if (this == &other)
+			return *this;
+
+		Clear();
+		TakeContents(other);
+
+		return *this;
 	}
 
 #pragma endregion